@@ -15,6 +15,10 @@
 
 namespace luabridge
 {
+    // metatable name of the optional full userdata type holding a glm::quat,
+    // accepted by Stack<glm::quat>::get() in place of a 4-element table
+    char const *const glmQuatMetatableName = "yg.math.Quat";
+
     template <>
     struct Stack<glm::quat>
     {
@@ -31,9 +35,16 @@ namespace luabridge
 
         static glm::quat get(lua_State *L, int index)
         {
+            // full userdata (yg.math.Quat): read in place
+            glm::quat const *ud = static_cast<glm::quat const *>(luaL_testudata(L, index, glmQuatMetatableName));
+            if (ud != nullptr)
+            {
+                return *ud;
+            }
+
             if (!lua_istable(L, index))
             {
-                luaL_error(L, "#%d argments must be table", index);
+                luaL_error(L, "#%d argments must be table or yg.math.Quat", index);
             }
 
             std::size_t const tableSize = static_cast<std::size_t>(get_length(L, index));
@@ -46,13 +57,11 @@ namespace luabridge
             glm::quat quat;
 
             int const absindex = lua_absindex(L, index);
-            lua_pushnil(L);
-            int arrayIndex = 0;
-            while (lua_next(L, absindex) != 0)
+            for (int i = 0; i < 4; ++i)
             {
-                quat[arrayIndex] = Stack<float>::get(L, -1);
+                lua_rawgeti(L, absindex, i + 1);
+                quat[i] = Stack<float>::get(L, -1);
                 lua_pop(L, 1);
-                ++arrayIndex;
             }
             return quat;
         }
@@ -15,6 +15,10 @@
 
 namespace luabridge
 {
+    // metatable name of the optional full userdata type holding a glm::vec3,
+    // accepted by Stack<glm::vec3>::get() in place of a 3-element table
+    char const *const glmVec3MetatableName = "yg.math.Vec3";
+
     template <>
     struct Stack<glm::vec3>
     {
@@ -31,9 +35,16 @@ namespace luabridge
 
         static glm::vec3 get(lua_State *L, int index)
         {
+            // full userdata (yg.math.Vec3): read in place
+            glm::vec3 const *ud = static_cast<glm::vec3 const *>(luaL_testudata(L, index, glmVec3MetatableName));
+            if (ud != nullptr)
+            {
+                return *ud;
+            }
+
             if (!lua_istable(L, index))
             {
-                luaL_error(L, "#%d argments must be table", index);
+                luaL_error(L, "#%d argments must be table or yg.math.Vec3", index);
             }
 
             std::size_t const tableSize = static_cast<std::size_t>(get_length(L, index));
@@ -46,13 +57,11 @@ namespace luabridge
             glm::vec3 vec;
 
             int const absindex = lua_absindex(L, index);
-            lua_pushnil(L);
-            int arrayIndex = 0;
-            while (lua_next(L, absindex) != 0)
+            for (int i = 0; i < 3; ++i)
             {
-                vec[arrayIndex] = Stack<float>::get(L, -1);
+                lua_rawgeti(L, absindex, i + 1);
+                vec[i] = Stack<float>::get(L, -1);
                 lua_pop(L, 1);
-                ++arrayIndex;
             }
             return vec;
         }
@@ -0,0 +1,31 @@
+// meant to be compatible with glsl 330 and 300 es
+// desired #version has to be prepended befor compiling
+
+// instanced variant of default.vert, used by yg.gl.DrawList.
+// mvpMat is the view-projection matrix here (DrawList draws with an identity
+// model matrix), the per-instance model matrices are in instModelMats, their
+// normal matrices (transposed inverse) in instNormalMats.
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexcoords;
+layout(location = 3) in vec3 inColor;
+
+out vec3 vOutPos;
+out vec3 vOutNorm;
+out vec2 vOutTex;
+out vec3 vOutCol;
+
+uniform mat4 mvpMat;
+uniform mat4 instModelMats[32]; // has to match DrawList::maxInstancesPerDraw
+uniform mat3 instNormalMats[32];
+
+void main()
+{
+    mat4 modelMat = instModelMats[gl_InstanceID];
+    vOutPos = (modelMat * vec4(inPosition, 1.0)).xyz;
+    vOutNorm = instNormalMats[gl_InstanceID] * inNormal;
+    vOutTex = inTexcoords;
+    vOutCol = inColor;
+    gl_Position = mvpMat * modelMat * vec4(inPosition, 1.0);
+}
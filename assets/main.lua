@@ -10,6 +10,11 @@ function init()
     geoGrid = yg.gl.loadGeometry("a//grid.obj")
     shdrDiff = yg.gl.loadVertFragShader("a//default.vert", "a//diffusecolor.frag")
     shdrSimple = yg.gl.loadVertFragShader("a//default.vert", "a//simplecolor.frag")
+    shdrDiffInst = yg.gl.loadVertFragShader("a//default_instanced.vert", "a//diffusecolor.frag")
+
+    -- draw list, filled in tick(). repeated geometry drawn with shdrDiff is drawn instanced
+    drawList = yg.gl.DrawList()
+    drawList:setInstancedShader(shdrDiff, shdrDiffInst)
 
     -- initialize audio
     yg.audio.init(2, 44100, 5)
@@ -31,43 +36,66 @@ function init()
     lightPos[1] = 4.07625; lightPos[2] = 5.90386; lightPos[3] = -1.00545
     light:setPosition(lightPos)
 
+    -- flavor parameter handles, read in tick()
+    flvTint = yg.flavor.handle("tint")
+    flvPosition = yg.flavor.handle("position")
+    flvRotation = yg.flavor.handle("rotation")
+    flvBounce = yg.flavor.handle("bounce")
+
+    -- vectors reused in tick(), filled in place
+    lightDiffuse = yg.math.Vec3()
+    cubeTrans = yg.math.Vec3()
+
+    -- input sources polled in tick(), read via one yg.input.snapshot() call
+    inputSources = {yg.input.WINDOW_ASPECT_RATIO,
+                    yg.input.KEY_LEFT, yg.input.KEY_RIGHT, yg.input.KEY_UP, yg.input.KEY_DOWN,
+                    yg.input.KEY_SPACE}
+
     -- dummy model Trafo (identity)
     t = yg.math.Trafo()
     t:setIdentity()
 end
 
-function tick()
+function tick(dt, time)
     -- update light 
-    lightDiffuse = yg.flavor.getVec3("tint")
+    yg.flavor.getVec3Into(flvTint, lightDiffuse)
     light:setDiffuse(lightDiffuse)
 
+    -- read input
+    inputSnap = yg.input.snapshot(inputSources, inputSnap)
+    local inp = inputSnap.get
+
     -- update camera from input
-    c:setPerspective(40, yg.input.get("WINDOW_ASPECT_RATIO"), 1, 100)
-    c:trafo():rotateGlobal(yg.time.getDelta() * 0.75 * yg.input.get("KEY_LEFT"), "Y")
-    c:trafo():rotateGlobal(yg.time.getDelta() * -0.75 * yg.input.get("KEY_RIGHT"), "Y")
-    c:trafo():rotateLocal(yg.time.getDelta() * 0.75 * yg.input.get("KEY_UP"), "X")
-    c:trafo():rotateLocal(yg.time.getDelta() * -0.75 * yg.input.get("KEY_DOWN"), "X")
+    c:setPerspective(40, inp[yg.input.WINDOW_ASPECT_RATIO], 1, 100)
+    c:trafo():rotateGlobal(dt * 0.75 * (inp[yg.input.KEY_LEFT] - inp[yg.input.KEY_RIGHT]), yg.math.Y)
+    c:trafo():rotateLocal(dt * 0.75 * (inp[yg.input.KEY_UP] - inp[yg.input.KEY_DOWN]), yg.math.X)
 
     -- update cube Trafo
-    t:rotateGlobal(yg.time.getDelta() * math.pi * 2 * yg.flavor.getNumber("rotation"), "Y")
-    cubeTrans = yg.flavor.getVec3("position")
-    cubeTrans[2] = cubeTrans[2] + math.sin((yg.time.getTime() - time0) * math.pi * 2 * yg.flavor.getNumber("bounce")) * 0.5
+    t:rotateGlobal(dt * math.pi * 2 * yg.flavor.getNumber(flvRotation), yg.math.Y)
+    yg.flavor.getVec3Into(flvPosition, cubeTrans)
+    cubeTrans.y = cubeTrans.y + math.sin((time - time0) * math.pi * 2 * yg.flavor.getNumber(flvBounce)) * 0.5
     t:setTranslation(cubeTrans)
 
     -- play audio
-    if yg.input.getDelta("KEY_SPACE") > 0.0 then
+    if inputSnap.getDelta[yg.input.KEY_SPACE] > 0.0 then
         yg.audio.play("a//laserSmall_000.ogg")
     end
 
     -- draw
-    yg.gl.draw(geoCube, light, shdrDiff, c, t)
-    yg.gl.draw(geoGrid, nil, shdrSimple, c, nil)
+    drawList:add(geoCube, shdrDiff, light, t)
+    drawList:add(geoGrid, shdrSimple, nil, nil)
+    drawList:flush(c)
+end
+
+-- optional, called after a changed script was re-executed (hot reload)
+function reload()
+    yg.log.info("ygif reload()...")
 end
 
 function shutdown()
     yg.log.info("ygif shutdown()...")
 
-    -- todo add mechanism to delete assets
+    -- loaded assets are released by the host when the Lua state closes
 
     yg.audio.shutdown()
 end
@@ -0,0 +1,24 @@
+#!/bin/bash
+# builds ygif_bench with PUC Lua and with LuaJIT (LUAJIT_ROOT: prefix of a
+# LuaJIT 2.1 build), and runs the bench scenes with both.
+# usage: bench/compare_backends.bash [ticks] (from the project root)
+
+if [ -z "$LUAJIT_ROOT" ]; then
+  echo "set LUAJIT_ROOT"
+  exit 1
+fi
+TICKS=${1:-1000}
+
+cmake -S . -B _build_bench_lua -DYOURGAME_PLATFORM=desktop -DCMAKE_BUILD_TYPE=RELEASE || exit 1
+cmake --build _build_bench_lua --target ygif_bench || exit 1
+cmake -S . -B _build_bench_luajit -DYOURGAME_PLATFORM=desktop -DCMAKE_BUILD_TYPE=RELEASE \
+  -DYGIF_LUAJIT=ON -DLUAJIT_ROOT="$LUAJIT_ROOT" || exit 1
+cmake --build _build_bench_luajit --target ygif_bench || exit 1
+
+for SCENE in bench/scenes/*.lua; do
+  for BUILD in _build_bench_lua _build_bench_luajit; do
+    BENCH=$(find $BUILD -name ygif_bench -type f | head -n 1)
+    $BENCH "$SCENE" $TICKS
+    echo
+  done
+done
@@ -0,0 +1,65 @@
+-- input polling: 40 sources per tick, get and getDelta values
+-- read with one yg.input.snapshot() call (1 Lua->C++ crossing per tick)
+
+sourceNames = {
+    "KEY_W",
+    "KEY_A",
+    "KEY_S",
+    "KEY_D",
+    "KEY_Q",
+    "KEY_E",
+    "KEY_R",
+    "KEY_F",
+    "KEY_SPACE",
+    "KEY_LEFT_SHIFT",
+    "KEY_LEFT",
+    "KEY_RIGHT",
+    "KEY_UP",
+    "KEY_DOWN",
+    "KEY_1",
+    "KEY_2",
+    "KEY_3",
+    "KEY_4",
+    "KEY_ESCAPE",
+    "KEY_ENTER",
+    "MOUSE_X",
+    "MOUSE_Y",
+    "MOUSE_BUTTON_1",
+    "MOUSE_BUTTON_2",
+    "SCROLL_OFFSET_Y",
+    "GAMEPAD_0_BUTTON_A",
+    "GAMEPAD_0_BUTTON_B",
+    "GAMEPAD_0_BUTTON_X",
+    "GAMEPAD_0_BUTTON_Y",
+    "GAMEPAD_0_BUTTON_DPAD_UP",
+    "GAMEPAD_0_BUTTON_DPAD_DOWN",
+    "GAMEPAD_0_BUTTON_DPAD_LEFT",
+    "GAMEPAD_0_BUTTON_DPAD_RIGHT",
+    "GAMEPAD_0_AXIS_LEFT_X",
+    "GAMEPAD_0_AXIS_LEFT_Y",
+    "GAMEPAD_0_AXIS_RIGHT_X",
+    "GAMEPAD_0_AXIS_RIGHT_Y",
+    "WINDOW_WIDTH",
+    "WINDOW_HEIGHT",
+    "WINDOW_ASPECT_RATIO"
+}
+
+function init()
+    sources = {}
+    for i, name in ipairs(sourceNames) do
+        sources[i] = yg.input.source(name)
+    end
+end
+
+function tick()
+    snap = yg.input.snapshot(sources, snap)
+    local get = snap.get
+    local getDelta = snap.getDelta
+    sum = 0.0
+    for i = 1, #sources do
+        sum = sum + get[sources[i]] + getDelta[sources[i]]
+    end
+end
+
+function shutdown()
+end
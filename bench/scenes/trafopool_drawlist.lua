@@ -0,0 +1,37 @@
+-- synthetic heavy scene: the 5000 objects of trafos_drawlist.lua in a
+-- yg.math.TrafoPool, rotated with one bulk call per tick and submitted
+-- instanced from the pool matrices
+
+numObjects = 5000
+
+function init()
+    geoCube = yg.gl.loadGeometry("a//cube.obj")
+    shdrDiff = yg.gl.loadVertFragShader("a//default.vert", "a//diffusecolor.frag")
+    shdrDiffInst = yg.gl.loadVertFragShader("a//default_instanced.vert", "a//diffusecolor.frag")
+
+    c = yg.math.Camera()
+    c:setPerspective(40, 16 / 9, 1, 500)
+    light = yg.gl.Lightsource()
+
+    drawList = yg.gl.DrawList()
+    drawList:setInstancedShader(shdrDiff, shdrDiffInst)
+
+    pool = yg.math.TrafoPool(numObjects)
+    local pos = yg.math.Vec3()
+    local rate = yg.math.Vec3()
+    for i = 1, numObjects do
+        pos:set((i % 100) * 2.0, 0.0, math.floor(i / 100) * 2.0)
+        pool:setTranslation(i, pos)
+        rate:set(0.0, 1.0 + (i % 7) * 0.1, 0.0)
+        pool:setRotationRate(i, rate)
+    end
+end
+
+function tick(dt)
+    pool:rotateAll(dt)
+    drawList:addPool(geoCube, shdrDiff, light, pool)
+    drawList:flush(c)
+end
+
+function shutdown()
+end
@@ -0,0 +1,33 @@
+-- synthetic heavy scene: 5000 Trafos, rotated every tick and
+-- drawn with one yg.gl.draw() call each
+
+numObjects = 5000
+
+function init()
+    geoCube = yg.gl.loadGeometry("a//cube.obj")
+    shdrDiff = yg.gl.loadVertFragShader("a//default.vert", "a//diffusecolor.frag")
+
+    c = yg.math.Camera()
+    c:setPerspective(40, 16 / 9, 1, 500)
+    light = yg.gl.Lightsource()
+
+    trafos = {}
+    local pos = yg.math.Vec3()
+    for i = 1, numObjects do
+        local t = yg.math.Trafo()
+        pos:set((i % 100) * 2.0, 0.0, math.floor(i / 100) * 2.0)
+        t:setTranslation(pos)
+        trafos[i] = t
+    end
+end
+
+function tick(dt)
+    for i = 1, numObjects do
+        local t = trafos[i]
+        t:rotateGlobal(dt * (1.0 + (i % 7) * 0.1), "Y")
+        yg.gl.draw(geoCube, light, shdrDiff, c, t)
+    end
+end
+
+function shutdown()
+end
@@ -0,0 +1,67 @@
+-- math-heavy scene without draws: 5000 Trafos rotated, moved along their
+-- local Z axis and read back every tick. uses yg.ffi (LuaJIT builds) if
+-- available, the yg.math bindings otherwise, to compare the Lua backends
+
+numObjects = 5000
+
+function init()
+    trafos = {}
+    local pos = yg.math.Vec3()
+    for i = 1, numObjects do
+        local t = yg.math.Trafo()
+        pos:set((i % 100) * 2.0, 0.0, math.floor(i / 100) * 2.0)
+        t:setTranslation(pos)
+        trafos[i] = t
+    end
+
+    if yg.ffi then
+        -- raw pointers, the Trafos are kept alive by trafos
+        ptrs = {}
+        for i = 1, numObjects do
+            ptrs[i] = yg.ffi.trafo(trafos[i])
+        end
+        eye = yg.ffi.vec3()
+        axis = yg.ffi.vec3()
+    else
+        eye = yg.math.Vec3()
+        axis = yg.math.Vec3()
+    end
+end
+
+function tickFfi(dt)
+    local api = yg.ffi.api
+    local sum = 0.0
+    for i = 1, numObjects do
+        local p = ptrs[i]
+        api.trafo_rotateGlobalAxis(p, dt * (1.0 + (i % 7) * 0.1), yg.ffi.Y)
+        api.trafo_getAxisLocal(p, yg.ffi.Z, axis)
+        api.trafo_translateGlobal(p, axis.x * dt, axis.y * dt, axis.z * dt)
+        api.trafo_getEye(p, eye)
+        sum = sum + eye:length()
+    end
+    dist = sum / numObjects
+end
+
+function tickBindings(dt)
+    local sum = 0.0
+    for i = 1, numObjects do
+        local t = trafos[i]
+        t:rotateGlobal(dt * (1.0 + (i % 7) * 0.1), yg.math.Y)
+        t:getAxisLocalInto(yg.math.Z, axis)
+        axis:scale(dt)
+        t:translateGlobal(axis)
+        t:getEyeInto(eye)
+        sum = sum + eye:length()
+    end
+    dist = sum / numObjects
+end
+
+-- tick() of the available API
+if yg.ffi then
+    tick = tickFfi
+else
+    tick = tickBindings
+end
+
+function shutdown()
+end
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_runtime.h"
+#include "ygif_bench_host.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+#if defined(YGIF_LUAJIT)
+#include "luajit.h"
+#endif
+}
+
+namespace yg = yourgame; // convenience
+
+// ygif_bench: runs a Lua scene headless, initLua() -> N * tickLua() -> shutdownLua(),
+// and reports per-tick latency, Lua heap size and allocation counts.
+//
+// usage: ygif_bench <scene.lua> [ticks] [dt replay file]
+//
+// the directory of scene.lua is used as project directory (p//), a
+// main_flavor.json next to it is loaded if it exists. the dt replay file
+// contains one frame delta (seconds) per line, replayed cyclically as
+// yg.time.getDelta(). default: fixed 1/60 s.
+namespace
+{
+    struct AllocStats
+    {
+        lua_Alloc allocf = nullptr;
+        void *ud = nullptr;
+        unsigned long allocs = 0;
+        unsigned long frees = 0;
+        unsigned long long bytes = 0;
+    };
+
+    // forwards to the original allocator of the Lua state, counts calls
+    void *countingAlloc(void *ud, void *ptr, size_t osize, size_t nsize)
+    {
+        AllocStats *stats = static_cast<AllocStats *>(ud);
+        if (nsize == 0)
+        {
+            if (ptr != nullptr)
+            {
+                ++stats->frees;
+            }
+        }
+        else if (ptr == nullptr || nsize > osize)
+        {
+            ++stats->allocs;
+            stats->bytes += (ptr == nullptr) ? nsize : (nsize - osize);
+        }
+        return stats->allocf(stats->ud, ptr, osize, nsize);
+    }
+
+    std::size_t luaHeapBytes(lua_State *L)
+    {
+        return static_cast<std::size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024u +
+               static_cast<std::size_t>(lua_gc(L, LUA_GCCOUNTB, 0));
+    }
+
+    double percentile(std::vector<double> const &sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        std::size_t i = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1u) + 0.5);
+        return sorted[std::min(i, sorted.size() - 1u)];
+    }
+
+    bool fileExists(std::string const &path)
+    {
+        std::ifstream f(path);
+        return f.good();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s <scene.lua> [ticks] [dt replay file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string scenePath = argv[1];
+    std::replace(scenePath.begin(), scenePath.end(), '\\', '/');
+    int numTicks = (argc > 2) ? std::atoi(argv[2]) : 1000;
+
+    if (argc > 3)
+    {
+        std::vector<double> dts;
+        std::ifstream f(argv[3]);
+        double dt;
+        while (f >> dt)
+        {
+            dts.push_back(dt);
+        }
+        mygame::bench::setDeltaReplay(dts);
+    }
+
+    // scene directory is the project directory
+    auto slash = scenePath.find_last_of('/');
+    std::string sceneDir = (slash == std::string::npos) ? "./" : scenePath.substr(0, slash + 1);
+    yg::file::setProjectPath(sceneDir);
+    mygame::g_luaScriptName = scenePath.substr(slash == std::string::npos ? 0 : slash + 1);
+
+    if (fileExists(sceneDir + mygame::g_flavorName))
+    {
+        mygame::loadFlavor();
+    }
+
+    auto tInit0 = std::chrono::steady_clock::now();
+    mygame::initLua();
+    auto tInit1 = std::chrono::steady_clock::now();
+    if (mygame::g_Lua == nullptr)
+    {
+        std::printf("%s: initLua() failed\n", scenePath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    AllocStats allocStats;
+    allocStats.allocf = lua_getallocf(mygame::g_Lua, &allocStats.ud);
+    lua_setallocf(mygame::g_Lua, countingAlloc, &allocStats);
+    mygame::bench::HostCounters initCounters = mygame::bench::getCounters();
+    mygame::bench::resetCounters();
+
+    std::vector<double> tickUs;
+    tickUs.reserve(static_cast<std::size_t>(std::max(numTicks, 0)));
+    std::size_t heapMin = luaHeapBytes(mygame::g_Lua);
+    std::size_t heapMax = heapMin;
+    unsigned long systemAllocs = 0; // of the pooled allocator below countingAlloc
+
+    for (int i = 0; i < numTicks; ++i)
+    {
+        mygame::bench::nextFrame();
+
+        auto t0 = std::chrono::steady_clock::now();
+        mygame::tickLua();
+        auto t1 = std::chrono::steady_clock::now();
+
+        if (mygame::g_Lua == nullptr)
+        {
+            std::printf("%s: tickLua() failed in tick %d\n", scenePath.c_str(), i);
+            return EXIT_FAILURE;
+        }
+
+        tickUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        systemAllocs += mygame::g_luaAlloc.stats().systemAllocs;
+        std::size_t heap = luaHeapBytes(mygame::g_Lua);
+        heapMin = std::min(heapMin, heap);
+        heapMax = std::max(heapMax, heap);
+    }
+
+    std::size_t heapFinal = luaHeapBytes(mygame::g_Lua);
+    mygame::LuaAllocator::Stats poolStats = mygame::g_luaAlloc.stats();
+    mygame::bench::HostCounters counters = mygame::bench::getCounters();
+
+    // restore the original allocator before the state is closed
+    lua_setallocf(mygame::g_Lua, allocStats.allocf, allocStats.ud);
+    mygame::shutdownLua();
+    mygame::g_resources.purge();
+    unsigned long resourceFrees = mygame::bench::getCounters().resourceFrees - counters.resourceFrees;
+
+    std::vector<double> sorted = tickUs;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (auto us : sorted)
+    {
+        sum += us;
+    }
+    double n = static_cast<double>(std::max(numTicks, 1));
+
+    std::printf("scene:              %s\n", scenePath.c_str());
+    std::printf("ticks:              %d\n", numTicks);
+#if defined(YGIF_LUAJIT)
+    std::printf("Lua backend:        %s\n", LUAJIT_VERSION);
+#else
+    std::printf("Lua backend:        %s\n", LUA_RELEASE);
+#endif
+    std::printf("init [ms]:          %.3f\n", std::chrono::duration<double, std::milli>(tInit1 - tInit0).count());
+    std::printf("tick [us]:          mean %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+                sum / n,
+                percentile(sorted, 0.5),
+                percentile(sorted, 0.9),
+                percentile(sorted, 0.99),
+                percentile(sorted, 1.0));
+    std::printf("Lua heap [bytes]:   min %zu, max %zu, final %zu\n", heapMin, heapMax, heapFinal);
+    std::printf("Lua allocs/tick:    %.2f (%.1f bytes), frees/tick: %.2f\n",
+                static_cast<double>(allocStats.allocs) / n,
+                static_cast<double>(allocStats.bytes) / n,
+                static_cast<double>(allocStats.frees) / n);
+    std::printf("Lua system allocs:  %.2f/tick, peak %zu bytes, %zu bytes in pool chunks\n",
+                static_cast<double>(systemAllocs) / n,
+                poolStats.peakBytes,
+                poolStats.chunkBytes);
+    std::printf("init loads:         %lu geometries, %lu shaders, %lu resources freed on shutdown\n",
+                initCounters.geometryLoads,
+                initCounters.shaderLoads,
+                resourceFrees);
+    std::printf("draws/tick:         %.2f, program binds/tick: %.2f, instance uploads/tick: %.2f\n",
+                static_cast<double>(counters.draws) / n,
+                static_cast<double>(counters.programBinds) / n,
+                static_cast<double>(counters.instanceUploads) / n);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+#include <cstdint>
+#include <deque>
+#include "ygif_host.h"
+#include "ygif_glstate.h"
+#include "ygif_bench_host.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+namespace yg = yourgame; // convenience
+
+// headless implementation of mygame::host: no window, GL context or audio
+// device. time and input are scripted and deterministic, loads and draws are
+// counted, but not executed.
+namespace mygame
+{
+    namespace
+    {
+        std::vector<double> g_dtReplay;
+        unsigned long g_frame = 0;
+        double g_delta = 0.0;
+        double g_time = 0.0;
+        bench::HostCounters g_counters;
+
+        // stand-ins for GPU resources. never dereferenced, the addresses only
+        // have to be distinct and stable
+        std::deque<std::uint64_t> g_dummyResources;
+
+        template <class T>
+        T *makeDummyResource()
+        {
+            g_dummyResources.push_back(0u);
+            return reinterpret_cast<T *>(&g_dummyResources.back());
+        }
+
+        // scripted input: value of source in frame
+        float inputValue(yg::input::Source source, unsigned long frame)
+        {
+            switch (source)
+            {
+            case yg::input::WINDOW_WIDTH:
+                return 1280.0f;
+            case yg::input::WINDOW_HEIGHT:
+                return 720.0f;
+            case yg::input::WINDOW_ASPECT_RATIO:
+                return 1280.0f / 720.0f;
+            // arrow keys: held in turns, 90 frames each
+            case yg::input::KEY_LEFT:
+                return ((frame / 90u) % 4u == 0u) ? 1.0f : 0.0f;
+            case yg::input::KEY_UP:
+                return ((frame / 90u) % 4u == 1u) ? 1.0f : 0.0f;
+            case yg::input::KEY_RIGHT:
+                return ((frame / 90u) % 4u == 2u) ? 1.0f : 0.0f;
+            case yg::input::KEY_DOWN:
+                return ((frame / 90u) % 4u == 3u) ? 1.0f : 0.0f;
+            // space: tapped every 45 frames
+            case yg::input::KEY_SPACE:
+                return (frame % 45u == 0u) ? 1.0f : 0.0f;
+            case yg::input::MOUSE_X:
+                return static_cast<float>(frame % 1280u);
+            case yg::input::MOUSE_Y:
+                return static_cast<float>((frame * 3u) % 720u);
+            default:
+                return 0.0f;
+            }
+        }
+
+        int noop(lua_State *L)
+        {
+            (void)L;
+            return 0;
+        }
+    } // namespace
+
+    namespace bench
+    {
+        void setDeltaReplay(std::vector<double> const &dts)
+        {
+            g_dtReplay = dts;
+        }
+
+        void nextFrame()
+        {
+            ++g_frame;
+            g_delta = g_dtReplay.empty() ? (1.0 / 60.0) : g_dtReplay[g_frame % g_dtReplay.size()];
+            g_time += g_delta;
+        }
+
+        HostCounters const &getCounters()
+        {
+            return g_counters;
+        }
+
+        void resetCounters()
+        {
+            g_counters = HostCounters();
+        }
+    }
+
+    namespace host
+    {
+        float inputGet(yg::input::Source source)
+        {
+            return inputValue(source, g_frame);
+        }
+
+        int inputGeti(yg::input::Source source)
+        {
+            return static_cast<int>(inputValue(source, g_frame));
+        }
+
+        float inputGetDelta(yg::input::Source source)
+        {
+            return inputValue(source, g_frame) - (g_frame > 0u ? inputValue(source, g_frame - 1u) : 0.0f);
+        }
+
+        double timeGetDelta()
+        {
+            return g_delta;
+        }
+
+        double timeGetTime()
+        {
+            return g_time;
+        }
+
+        double timeGetClockPeriod()
+        {
+            return 1.0e-9;
+        }
+
+        yg::gl::Geometry *loadGeometry(std::string const &filename)
+        {
+            (void)filename;
+            ++g_counters.geometryLoads;
+            return makeDummyResource<yg::gl::Geometry>();
+        }
+
+        yg::gl::Geometry *makeGeometry(MeshView const &mesh)
+        {
+            (void)mesh;
+            ++g_counters.geometryLoads;
+            return makeDummyResource<yg::gl::Geometry>();
+        }
+
+        yg::gl::Shader *loadVertFragShader(std::string const &vertFilename, std::string const &fragFilename)
+        {
+            (void)vertFilename;
+            (void)fragFilename;
+            ++g_counters.shaderLoads;
+            return makeDummyResource<yg::gl::Shader>();
+        }
+
+        void freeGeometry(yg::gl::Geometry *geo)
+        {
+            (void)geo;
+            ++g_counters.resourceFrees;
+        }
+
+        void freeShader(yg::gl::Shader *shader)
+        {
+            g_glState.forgetProgram(shader);
+            ++g_counters.resourceFrees;
+        }
+
+        bool audioStoreFile(std::string const &filename)
+        {
+            (void)filename;
+            return true;
+        }
+
+        void useProgram(yg::gl::Shader *shader,
+                        yg::gl::Lightsource *light,
+                        yg::math::Camera *camera)
+        {
+            // state tracking as in ygif_host.cpp, binds are counted
+            GlStateCache::Action a = g_glState.use(shader, light, camera);
+            if (a.bind || a.uploadLight || a.uploadCamera)
+            {
+                ++g_counters.programBinds;
+            }
+        }
+
+        void drawGeo(yg::gl::Geometry *geo, yg::gl::DrawConfig const &cfg)
+        {
+            (void)geo;
+            (void)cfg;
+            ++g_counters.draws;
+        }
+
+        void uploadInstanceModelMats(yg::gl::Shader *instancedShader, glm::mat4 const *mats, int n)
+        {
+            (void)instancedShader;
+            (void)mats;
+            (void)n;
+            ++g_counters.instanceUploads;
+        }
+
+        void registerLua(lua_State *L)
+        {
+            luabridge::getGlobalNamespace(L)
+                .beginNamespace("yg")
+                // namespace audio ...
+                .beginNamespace("audio")
+                .addFunction("init", noop)
+                .addFunction("shutdown", noop)
+                .addFunction("isInitialized", noop)
+                .addFunction("play", noop)
+                .addFunction("stop", noop)
+                .addFunction("pause", noop)
+                .addFunction("setChannelGains", noop)
+                .endNamespace()
+                // namespace control ...
+                .beginNamespace("control")
+                .addFunction("exit", noop)
+                .addFunction("sendCmdToEnv", noop)
+                .addFunction("enableFullscreen", noop)
+                .addFunction("enableVSync", noop)
+                .addFunction("catchMouse", noop)
+                .endNamespace()
+                // end of namespace yg
+                .endNamespace();
+        }
+    }
+}
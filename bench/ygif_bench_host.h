@@ -0,0 +1,34 @@
+#ifndef YGIF_BENCH_HOST_H
+#define YGIF_BENCH_HOST_H
+
+#include <string>
+#include <vector>
+
+namespace mygame
+{
+    // control of the headless host (ygif_bench_host.cpp), which replaces
+    // ygif_host.cpp in ygif_bench
+    namespace bench
+    {
+        struct HostCounters
+        {
+            unsigned long geometryLoads = 0;
+            unsigned long shaderLoads = 0;
+            unsigned long resourceFrees = 0;
+            unsigned long programBinds = 0;
+            unsigned long draws = 0;
+            unsigned long instanceUploads = 0;
+        };
+
+        // replays dts (cycling) as yg.time.getDelta(). empty: fixed 1/60 s
+        void setDeltaReplay(std::vector<double> const &dts);
+
+        // advances time and scripted input to the next frame
+        void nextFrame();
+
+        HostCounters const &getCounters();
+        void resetCounters();
+    }
+}
+
+#endif
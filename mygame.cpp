@@ -17,27 +17,27 @@ freely, subject to the following restrictions:
    misrepresented as being the original software.
 3. This notice may not be removed or altered from any source distribution.
 */
-#include <algorithm> // std::replace()
+#include <algorithm> // std::replace(), std::sort()
+#include <cfloat>
+#include <cstdio>
 #include <cstring>
+#include <memory>
 #include <vector>
 #include <set>
 #include "yourgame/yourgame.h"
-#include "nlohmann/json.hpp"
 #include "mygame_version.h"
-#include "ygif_glue.h"
+#include "ygif_flavor.h"
+#include "ygif_runtime.h"
+#include "ygif_async.h"
+#include "ygif_profiler.h"
+#include "ygif_culling.h"
+#include "ygif_glstate.h"
+#include "ygif_explorer.h"
+#include "ygif_pagedfile.h"
 #include "imgui.h"
 #include "TextEditor.h" // this is ImGuiColorTextEdit
 #include "imgui_memory_editor.h"
 
-extern "C"
-{
-#include "lua.h"
-#include "lualib.h"
-#include "lauxlib.h"
-}
-#include "LuaBridge/LuaBridge.h"
-
-using json = nlohmann::json;
 namespace yg = yourgame; // convenience
 
 namespace mygame
@@ -46,6 +46,7 @@ namespace mygame
     {
         bool *winOpened;
         TextEditor editor;
+        std::shared_ptr<AsyncFileRead> pendingRead; // content, until it is set
         FileTextEditor()
         {
             winOpened = new bool{true};
@@ -60,10 +61,20 @@ namespace mygame
     {
         bool *winOpened;
         MemoryEditor editor;
-        std::vector<uint8_t> data;
+        PagedFile file; // mapped or paged, edits in a page overlay
         FileHexEditor()
         {
             winOpened = new bool{true};
+
+            // the PagedFile is passed as memory to the editor
+            editor.ReadFn = [](const ImU8 *mem, size_t off) -> ImU8
+            {
+                return reinterpret_cast<PagedFile *>(const_cast<ImU8 *>(mem))->read(off);
+            };
+            editor.WriteFn = [](ImU8 *mem, size_t off, ImU8 d)
+            {
+                reinterpret_cast<PagedFile *>(mem)->write(off, d);
+            };
         }
         ~FileHexEditor()
         {
@@ -78,30 +89,23 @@ namespace mygame
         "LICENSE_android.txt",
         "LICENSE_web.txt"};
 
-    // initial Lua script name to execute.
-    // if project path set: try to load p//<g_luaScriptName>
-    // else: try to load a//<g_luaScriptName>.
-    std::string g_luaScriptName = "main.lua";
-
-    // initial flavor to load.
-    // if project path set: try to load p//<g_flavorName>
-    // else: try to load a//<g_flavorName>.
-    std::string g_flavorName = "main_flavor.json";
-
     std::map<std::string, FileTextEditor> g_openedEditors;
     std::map<std::string, FileHexEditor> g_openedHexEditors;
     std::string *g_licenseStr = nullptr;
-    lua_State *g_Lua = nullptr;
-    json g_flavor;
+
+    // content of the Explorer, changes in the project drive the hot reload
+    ExplorerTree g_assetTree("a//", g_excludeFiles);
+    ExplorerTree g_projectTree("p//", g_excludeFiles);
 
     bool g_renderImgui = true;
+    bool g_hotReload = true;
+    double g_hotReloadPollTime = 0.0;
+    bool g_showProfiler = false;
 
     // forward declarations
     void renderImgui();
-    void initLua();
-    void tickLua();
-    void shutdownLua();
-    void loadFlavor();
+    void renderExplorerTree(ExplorerTree &tree);
+    void renderProfiler();
 
     void init(int argc, char *argv[])
     {
@@ -138,6 +142,8 @@ namespace mygame
 
     void tick()
     {
+        g_profiler.beginFrame(yg::time::getDelta(), g_Lua);
+
         // reinit Lua if F5 was hit
         if (yg::input::getDelta(yg::input::KEY_F5) > 0.0f)
         {
@@ -146,6 +152,68 @@ namespace mygame
             initLua();
         }
 
+        g_assetTree.update(yg::time::getTime());
+        g_projectTree.update(yg::time::getTime());
+        g_assetTree.takeChanged(); // only the project is hot reloaded
+        std::vector<std::string> changedFiles = g_projectTree.takeChanged();
+
+        // files written elsewhere (text editor, flavor): Hex Editors without
+        // edits show the new content and size
+        for (auto const &f : changedFiles)
+        {
+            auto hex = g_openedHexEditors.find(f);
+            if (hex != g_openedHexEditors.end() && hex->second.file.numDirtyPages() == 0)
+            {
+                hex->second.file.open(f);
+            }
+        }
+
+        // hot reload: re-execute changed project scripts. if watched, as
+        // reported by the index: a changed flavor file is loaded again,
+        // changed resource files restart Lua (like F5), unchanged resources
+        // are reused from the cache. polling: all scripts are checked, twice
+        // per second
+        if (g_hotReload && g_projectTree.rootIndex().isWatching())
+        {
+            bool restart = false;
+            for (auto const &f : changedFiles)
+            {
+                if (f == getFlavorFilename())
+                {
+                    loadFlavor();
+                }
+                else if (g_resources.usesFile(f))
+                {
+                    restart = true;
+                }
+            }
+            if (restart)
+            {
+                shutdownLua();
+                loadFlavor();
+                initLua();
+            }
+            else
+            {
+                // modules in subdirectories are not watched, polled
+                g_hotReloadPollTime += yg::time::getDelta();
+                if (!changedFiles.empty() || g_hotReloadPollTime >= 0.5)
+                {
+                    g_hotReloadPollTime = 0.0;
+                    reloadLua(&changedFiles);
+                }
+            }
+        }
+        else if (g_hotReload)
+        {
+            g_hotReloadPollTime += yg::time::getDelta();
+            if (g_hotReloadPollTime >= 0.5)
+            {
+                g_hotReloadPollTime = 0.0;
+                reloadLua();
+            }
+        }
+
         // toggle GUI
         if (yg::input::getDelta(yg::input::KEY_TAB) > 0.0f)
         {
@@ -167,9 +235,21 @@ namespace mygame
 
         if (g_renderImgui)
         {
+            ProfileScope scope(Profiler::SECTION_RENDER_IMGUI);
             renderImgui();
         }
 
+        // fill editors with the content of finished file reads
+        for (auto &w : g_openedEditors)
+        {
+            if (w.second.pendingRead && w.second.pendingRead->done)
+            {
+                auto const &data = w.second.pendingRead->data;
+                w.second.editor.SetText(std::string(data.begin(), data.end()));
+                w.second.pendingRead.reset();
+            }
+        }
+
         // remove closed Code Editor windows
         for (auto it = g_openedEditors.cbegin(); it != g_openedEditors.cend();)
         {
@@ -196,7 +276,10 @@ namespace mygame
             }
         }
 
-        tickLua();
+        {
+            ProfileScope scope(Profiler::SECTION_TICK_LUA);
+            tickLua();
+        }
     }
 
     void shutdown()
@@ -207,6 +290,7 @@ namespace mygame
         }
 
         shutdownLua();
+        g_resources.purge();
     }
 
     void renderImgui()
@@ -228,6 +312,7 @@ namespace mygame
             if (ImGui::BeginMenu("View"))
             {
                 ImGui::MenuItem("Render GUI", "TAB", &g_renderImgui);
+                ImGui::MenuItem("Profiler", nullptr, &g_showProfiler);
                 if (ImGui::MenuItem("Fullscreen", "F11", yg::input::geti(yg::input::WINDOW_FULLSCREEN)))
                 {
                     yg::control::enableFullscreen(!yg::input::geti(yg::input::WINDOW_FULLSCREEN));
@@ -242,6 +327,7 @@ namespace mygame
                     loadFlavor();
                     initLua();
                 }
+                ImGui::MenuItem("Hot Reload", nullptr, &g_hotReload);
                 ImGui::EndMenu();
             }
             if (ImGui::BeginMenu("Help"))
@@ -274,83 +360,36 @@ namespace mygame
 
         // Explorer
         {
-            // get asset files
-            std::vector<std::string> assetFiles = yg::file::ls("a//*");
-
-            // get project files
-            std::vector<std::string> projectFiles;
-            if (yg::file::getProjectFilePath("") != "")
-            {
-                projectFiles = yg::file::ls("p//*");
-            }
-
             ImGui::SetNextWindowPos({0.0f, mainMenuBarHeight});
             ImGui::SetNextWindowSizeConstraints({200.0f, sideBarHeight}, {500.0f, sideBarHeight});
             ImGui::Begin("Explorer", nullptr, (0));
 
-            // lambda for button drawing, used multiple times below (collapsing headers)
-            auto drawButtons = [](const std::vector<std::string> &filenames, const std::string &filePrefix)
+            // fuzzy filter over the listed folders of both sections
+            static char filter[128] = "";
+            if (ImGui::InputText("Filter", filter, sizeof(filter)))
             {
-                for (const auto &f : filenames)
-                {
-                    if (g_excludeFiles.find(f) != g_excludeFiles.end())
-                    {
-                        continue;
-                    }
-
-                    std::string file = filePrefix + f;
-
-                    if (ImGui::Button((std::string("txt##") + f + filePrefix).c_str()))
-                    {
-                        // open new Code Editor window
-                        if (g_openedEditors.find(file) == g_openedEditors.end())
-                        {
-                            // read file
-                            std::vector<uint8_t> data;
-                            yg::file::readFile(file, data);
-
-                            // insert new default-constructed FileTextEditor
-                            g_openedEditors[file];
-
-                            // set editor language
-                            if (yg::file::getFileExtension(file).compare("lua") == 0)
-                            {
-                                g_openedEditors[file].editor.SetLanguageDefinition(TextEditor::LanguageDefinition::Lua());
-                            }
-                            else if ((yg::file::getFileExtension(file).compare("vert") == 0) ||
-                                     (yg::file::getFileExtension(file).compare("frag") == 0))
-                            {
-                                g_openedEditors[file].editor.SetLanguageDefinition(TextEditor::LanguageDefinition::GLSL());
-                            }
-
-                            // fill editor with initial content
-                            std::string dataStr = std::string(data.begin(), data.end());
-                            g_openedEditors[file].editor.SetText(dataStr);
-                        }
-                    }
-
-                    ImGui::SameLine();
-                    if (ImGui::Button((std::string("bin##") + f + filePrefix).c_str()))
-                    {
-                        // insert new default-constructed FileHexEditor
-                        g_openedHexEditors[file];
-
-                        // read file
-                        yg::file::readFile(file, g_openedHexEditors[file].data);
-                    }
-                    ImGui::SameLine();
-                    ImGui::Text("%s", f.c_str());
-                }
-            };
+                g_assetTree.setFilter(filter);
+                g_projectTree.setFilter(filter);
+            }
 
             if (ImGui::CollapsingHeader("Assets", ImGuiTreeNodeFlags_DefaultOpen))
             {
-                drawButtons(assetFiles, "a//");
+                renderExplorerTree(g_assetTree);
             }
 
             if (ImGui::CollapsingHeader("Project", ImGuiTreeNodeFlags_DefaultOpen))
             {
-                drawButtons(projectFiles, "p//");
+                renderExplorerTree(g_projectTree);
+            }
+
+            if (ImGui::CollapsingHeader("Resources"))
+            {
+                ResourceCache::Stats stats = g_resources.stats();
+                ImGui::Text("geometries: %d", stats.geometries);
+                ImGui::Text("shaders: %d", stats.shaders);
+                ImGui::Text("audio files: %d", stats.audioFiles);
+                ImGui::Text("refs: %d", stats.refs);
+                ImGui::Text("source files: %.1f KiB", static_cast<double>(stats.bytes) / 1024.0);
             }
 
             ImGui::End();
@@ -362,54 +401,36 @@ namespace mygame
             ImGui::Begin("Flavor", nullptr, (0));
             ImGui::SetWindowPos({yg::input::get(yg::input::WINDOW_WIDTH) - ImGui::GetWindowSize().x, mainMenuBarHeight});
 
-            for (auto &el : g_flavor.items())
+            if (ImGui::Button("Save"))
             {
-                auto &v = el.value();
-
-                // todo: simplify entire json logic by validating with schema
-                if (!v.contains("type") || !v.contains("data"))
-                {
-                    continue;
-                }
+                saveFlavor();
+            }
 
-                std::string type = v["type"].get<std::string>();
-                std::string name = el.key();
+            for (std::size_t i = 0; i < g_flavorParams.size(); ++i)
+            {
+                int h = static_cast<int>(i);
+                auto &p = g_flavorParams.param(h);
+                auto const &info = g_flavorParams.info(h);
 
-                ImGui::PushID(name.c_str());
-                if (ImGui::CollapsingHeader(name.c_str(), ImGuiTreeNodeFlags_DefaultOpen))
+                ImGui::PushID(info.name.c_str());
+                if (ImGui::CollapsingHeader(info.name.c_str(), ImGuiTreeNodeFlags_DefaultOpen))
                 {
-                    // todo: assuming data matches type. prefer validating with schema
-                    if (type.compare("number") == 0)
+                    if (p.type == FlavorStore::Type::NUMBER)
                     {
-                        float data = v["data"].get<float>();
-
-                        std::string unit = v.contains("unit") ? v["unit"].get<std::string>() : "";
-                        ImGui::DragFloat(unit.c_str(), &data, 0.001f);
-
-                        v["data"] = data;
+                        ImGui::DragFloat(info.unit.c_str(), &(p.data[0]), 0.001f);
                     }
-                    else if (type.compare("vec3") == 0)
+                    else if (p.type == FlavorStore::Type::VEC3)
                     {
-                        float data[3];
-                        data[0] = v["data"][0].get<float>();
-                        data[1] = v["data"][1].get<float>();
-                        data[2] = v["data"][2].get<float>();
-
-                        std::string usage = v.contains("usage") ? v["usage"].get<std::string>() : "";
-                        if (usage.compare("color") == 0)
+                        if (info.usage.compare("color") == 0)
                         {
-                            ImGui::ColorPicker3("", data);
+                            ImGui::ColorPicker3("", p.data);
                         }
                         else
                         {
-                            ImGui::DragFloat("X", &(data[0]), 0.001f);
-                            ImGui::DragFloat("Y", &(data[1]), 0.001f);
-                            ImGui::DragFloat("Z", &(data[2]), 0.001f);
+                            ImGui::DragFloat("X", &(p.data[0]), 0.001f);
+                            ImGui::DragFloat("Y", &(p.data[1]), 0.001f);
+                            ImGui::DragFloat("Z", &(p.data[2]), 0.001f);
                         }
-
-                        v["data"][0] = data[0];
-                        v["data"][1] = data[1];
-                        v["data"][2] = data[2];
                     }
                 }
                 ImGui::PopID();
@@ -418,6 +439,11 @@ namespace mygame
             ImGui::End();
         }
 
+        if (g_showProfiler)
+        {
+            renderProfiler();
+        }
+
         // Code Editor windows
         for (auto &w : g_openedEditors)
         {
@@ -431,7 +457,7 @@ namespace mygame
             {
                 if (ImGui::BeginMenu("File"))
                 {
-                    if (ImGui::MenuItem("Save"))
+                    if (ImGui::MenuItem("Save") && !w.second.pendingRead)
                     {
                         std::string textToSave = w.second.editor.GetText();
                         yg::file::writeFile(w.first, &(textToSave[0]), textToSave.size());
@@ -458,164 +484,262 @@ namespace mygame
             {
                 if (ImGui::BeginMenu("File"))
                 {
-                    if (ImGui::MenuItem("Save"))
+                    if (ImGui::MenuItem("Save", nullptr, false, w.second.file.numDirtyPages() > 0))
                     {
-                        yg::file::writeFile(w.first, &(w.second.data[0]), w.second.data.size());
+                        w.second.file.save();
                     }
                     ImGui::EndMenu();
                 }
+                ImGui::Text("%zu modified pages", w.second.file.numDirtyPages());
                 ImGui::EndMenuBar();
             }
 
-            w.second.editor.DrawContents(&(w.second.data[0]), w.second.data.size());
+            w.second.editor.DrawContents(&(w.second.file), w.second.file.size());
             ImGui::End();
         }
     }
 
-    void initLua()
+    // rows of tree, only the visible ones are submitted
+    void renderExplorerTree(ExplorerTree &tree)
     {
-        if (g_Lua == nullptr)
-        {
-            // initialize Lua, register C++ components
-            g_Lua = luaL_newstate();
-            luaL_openlibs(g_Lua);
-            mygame::registerLua(g_Lua);
+        std::vector<int> const &rows = tree.rows();
+        float indent = ImGui::GetTreeNodeToLabelSpacing();
+        int toggled = -1;
 
-            // run Lua code
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step())
+        {
+            for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r)
             {
-                // load initial Lua script from assets, or project path, if set
-                std::string luaScriptName = "a//" + g_luaScriptName;
-                if (yg::file::getProjectFilePath("") != "")
+                ExplorerTree::Entry const &e = tree.entry(rows[r]);
+                if (!tree.isFiltered())
                 {
-                    luaScriptName = "p//" + g_luaScriptName;
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + indent * static_cast<float>(e.depth));
                 }
 
-                // load lua script
-                std::vector<uint8_t> data;
-                if (yg::file::readFile(luaScriptName, data) == 0)
+                if (e.isDir)
                 {
-                    // add null terminator for luaL_dostring()
-                    data.push_back((uint8_t)0);
-                }
-                else
-                {
-                    yg::log::error("failed to load Lua code from file %v", luaScriptName);
+                    if (ImGui::ArrowButton(e.txtLabel.c_str(), tree.isExpanded(rows[r]) ? ImGuiDir_Down : ImGuiDir_Right))
+                    {
+                        toggled = rows[r]; // changes the rows
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextUnformatted(e.name.c_str());
+                    continue;
                 }
 
-                if (luaL_dostring(g_Lua, (char *)(&data[0])) != 0)
-                {
-                    yg::log::error("Lua error: %v", lua_tostring(g_Lua, -1));
-                    shutdownLua();
-                }
-                else
+                if (ImGui::Button(e.txtLabel.c_str()))
                 {
-                    // Lua: call init()
-                    luabridge::LuaRef lInit = luabridge::getGlobal(g_Lua, "init");
-                    if (lInit.isFunction())
+                    // open new Code Editor window
+                    if (g_openedEditors.find(e.file) == g_openedEditors.end())
                     {
-                        try
+                        // insert new default-constructed FileTextEditor,
+                        // read file on the job pool
+                        g_openedEditors[e.file].pendingRead = readFileAsync(e.file);
+
+                        // set editor language
+                        if (yg::file::getFileExtension(e.file).compare("lua") == 0)
                         {
-                            lInit();
+                            g_openedEditors[e.file].editor.SetLanguageDefinition(TextEditor::LanguageDefinition::Lua());
                         }
-                        catch (luabridge::LuaException const &e)
+                        else if ((yg::file::getFileExtension(e.file).compare("vert") == 0) ||
+                                 (yg::file::getFileExtension(e.file).compare("frag") == 0))
                         {
-                            yg::log::error("initLua(): Lua exception: %v", std::string(e.what()));
-                            shutdownLua();
+                            g_openedEditors[e.file].editor.SetLanguageDefinition(TextEditor::LanguageDefinition::GLSL());
                         }
                     }
                 }
+
+                ImGui::SameLine();
+                if (ImGui::Button(e.binLabel.c_str()))
+                {
+                    // insert new default-constructed FileHexEditor, map
+                    // the file (no read)
+                    if (g_openedHexEditors.find(e.file) == g_openedHexEditors.end() &&
+                        !g_openedHexEditors[e.file].file.open(e.file))
+                    {
+                        yg::log::error("failed to open %v", e.file);
+                        g_openedHexEditors.erase(e.file);
+                    }
+                }
+                ImGui::SameLine();
+                ImGui::TextUnformatted(tree.isFiltered() ? e.path.c_str() : e.name.c_str());
             }
         }
-        else
+        clipper.End();
+
+        if (toggled >= 0)
         {
-            yg::log::error("initLua(): g_Lua != nullptr");
+            tree.setExpanded(toggled, !tree.isExpanded(toggled));
         }
     }
 
-    void tickLua()
+    void renderProfiler()
     {
-        if (g_Lua != nullptr)
+        ImGui::Begin("Profiler", &g_showProfiler, (0));
+        ImGui::SetWindowSize(ImVec2(yg::input::get(yg::input::WINDOW_WIDTH) * 0.4f,
+                                    yg::input::get(yg::input::WINDOW_HEIGHT) * 0.6f),
+                             ImGuiCond_FirstUseEver);
+
+        // frame time, split into sections
+        for (int s = 0; s < Profiler::NUM_SECTIONS; ++s)
+        {
+            auto section = static_cast<Profiler::Section>(s);
+            std::vector<float> h = g_profiler.sectionHistory(section);
+            char overlay[32];
+            std::snprintf(overlay, sizeof(overlay), "%.2f ms", h.empty() ? 0.0f : h.back());
+            ImGui::PlotLines(Profiler::sectionName(section), h.data(), static_cast<int>(h.size()),
+                             0, overlay, 0.0f, 20.0f, ImVec2(0.0f, 40.0f));
+        }
+        {
+            std::vector<float> h = g_profiler.luaMemoryHistory();
+            char overlay[32];
+            std::snprintf(overlay, sizeof(overlay), "%.0f KiB", h.empty() ? 0.0f : h.back());
+            ImGui::PlotLines("Lua memory", h.data(), static_cast<int>(h.size()),
+                             0, overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+        }
         {
-            // Lua: call tick()
-            luabridge::LuaRef lTick = luabridge::getGlobal(g_Lua, "tick");
-            if (lTick.isFunction())
+            LuaAllocator::Stats const &mem = g_luaAlloc.stats();
+            LuaAllocator::Stats const &tick = g_luaAlloc.lastTick();
+            ImGui::Text("Lua heap: %zu KiB (peak %zu KiB, %zu KiB pooled), allocs/tick: %lu (%lu malloc), frees/tick: %lu",
+                        mem.liveBytes / 1024u, mem.peakBytes / 1024u, mem.chunkBytes / 1024u,
+                        tick.allocs, tick.systemAllocs, tick.frees);
+            if (mem.failedAllocs > 0)
             {
-                try
-                {
-                    lTick();
-                }
-                catch (luabridge::LuaException const &e)
-                {
-                    yg::log::error("tickLua(): Lua exception: %v", std::string(e.what()));
-                    shutdownLua();
-                }
+                ImGui::SameLine();
+                ImGui::Text(", %lu failed (limit)", mem.failedAllocs);
             }
         }
-    }
 
-    void shutdownLua()
-    {
-        if (g_Lua != nullptr)
+        ImGui::Text("draws: %d, culled: %d", g_profiler.drawnLastFrame(), g_profiler.culledLastFrame());
+        GlStateCache::Counters const &gl = g_glState.lastFrame();
+        ImGui::Text("program binds: %d (%d avoided), uniform uploads: %d (%d avoided)",
+                    gl.programBinds, gl.programBindsAvoided, gl.uniformUploads, gl.uniformUploadsAvoided);
+        ImGui::SameLine();
+        ImGui::Checkbox("Frustum Culling", &g_frustumCulling);
+
+        bool sampling = g_profiler.isSampling();
+        if (ImGui::Checkbox("Sample Lua", &sampling))
+        {
+            g_profiler.enableSampling(sampling);
+            applyLuaSettings();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
         {
-            // Lua: call shutdown()
-            // the extra scope is crucial. lShutdown has to be destroyed before
-            // lua_close() is called.
+            g_profiler.resetStats();
+        }
+
+        // Chrome trace capture (chrome://tracing, Perfetto)
+        if (!g_profiler.isCapturing())
+        {
+            if (ImGui::Button("Start Capture"))
             {
-                luabridge::LuaRef lShutdown = luabridge::getGlobal(g_Lua, "shutdown");
-                if (lShutdown.isFunction())
-                {
-                    try
-                    {
-                        lShutdown();
-                    }
-                    catch (luabridge::LuaException const &e)
-                    {
-                        yg::log::error("shutdownLua(): Lua exception: %v", std::string(e.what()));
-                    }
-                }
+                g_profiler.startCapture();
             }
-
-            lua_close(g_Lua);
-            g_Lua = nullptr;
         }
-        else
+        else if (ImGui::Button("Stop Capture"))
         {
-            yg::log::error("shutdownLua(): g_Lua == nullptr");
+            g_profiler.stopCapture();
         }
-    }
-
-    void loadFlavor()
-    {
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace") && !g_profiler.isCapturing())
         {
-            // load initial flavor file from assets, or project path, if set
-            std::string flavorName = "a//" + g_flavorName;
-            if (yg::file::getProjectFilePath("") != "")
+            // not into the project: the trace would show up in the explorer and as a change
+            std::string traceFile = "s//ygif_trace.json";
+            if (g_profiler.exportChromeTrace(traceFile))
             {
-                flavorName = "p//" + g_flavorName;
+                yg::log::info("trace exported: %v", traceFile);
             }
+            else
+            {
+                yg::log::error("trace export failed: %v", traceFile);
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Text("%d events", static_cast<int>(g_profiler.numCapturedEvents()));
 
-            // load flavor file
-            std::vector<uint8_t> data;
-            if (yg::file::readFile(flavorName, data) == 0)
+        if (ImGui::CollapsingHeader("Lua Budget"))
+        {
+            bool changed = false;
+            float tickLimitMs = static_cast<float>(g_luaSettings.tickTimeLimit * 1000.0);
+            if (ImGui::DragFloat("tick time limit [ms]", &tickLimitMs, 1.0f, 0.0f, 10000.0f))
             {
-                // add null terminator
-                data.push_back((uint8_t)0);
+                g_luaSettings.tickTimeLimit = tickLimitMs / 1000.0;
+                changed = true;
             }
-            else
+            int instructionLimit = static_cast<int>(g_luaSettings.tickInstructionLimit);
+            if (ImGui::InputInt("tick instruction limit", &instructionLimit, 100000, 1000000))
+            {
+                g_luaSettings.tickInstructionLimit = static_cast<unsigned long>(std::max(0, instructionLimit));
+                changed = true;
+            }
+            int gcMode = static_cast<int>(g_luaSettings.gcMode);
+            if (ImGui::Combo("GC mode", &gcMode, "incremental\0generational\0manual\0"))
             {
-                yg::log::error("failed to load flavor from file %v", flavorName);
-                return;
+                g_luaSettings.gcMode = static_cast<LuaSettings::GcMode>(gcMode);
+                changed = true;
             }
+            changed |= ImGui::SliderInt("GC pause [%]", &g_luaSettings.gcPause, 50, 400);
+            changed |= ImGui::SliderInt("GC step mul [%]", &g_luaSettings.gcStepMul, 50, 1000);
+            float stepBudgetMs = static_cast<float>(g_luaSettings.gcStepBudget * 1000.0);
+            if (ImGui::DragFloat("GC step budget [ms]", &stepBudgetMs, 0.01f, 0.0f, 8.0f))
+            {
+                g_luaSettings.gcStepBudget = stepBudgetMs / 1000.0;
+            }
+            int memoryLimitMiB = static_cast<int>(g_luaSettings.memoryLimit / (1024u * 1024u));
+            if (ImGui::InputInt("memory limit [MiB]", &memoryLimitMiB, 1, 16))
+            {
+                g_luaSettings.memoryLimit = static_cast<std::size_t>(std::max(0, memoryLimitMiB)) * 1024u * 1024u;
+                changed = true;
+            }
+            if (changed)
+            {
+                applyLuaSettings();
+            }
+        }
 
-            try
+        if (ImGui::CollapsingHeader("Bindings", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            // bindings are wrapped when the Lua state starts: restart it
+            if (ImGui::Checkbox("Profile Bindings", &g_profileBindings) && g_Lua != nullptr)
             {
-                g_flavor = json::parse(&(data[0]));
+                shutdownLua();
+                initLua();
             }
-            catch (json::parse_error &e)
+
+            // called bindings, most time first
+            std::vector<Profiler::BindingStats> bindings;
+            for (auto const &b : g_profiler.bindingStats())
             {
-                yg::log::warn("failed to parse json (flavor): %v", std::string(e.what()));
-                return;
+                if (b.calls > 0)
+                {
+                    bindings.push_back(b);
+                }
+            }
+            std::sort(bindings.begin(), bindings.end(), [](Profiler::BindingStats const &a, Profiler::BindingStats const &b)
+                      { return a.seconds > b.seconds; });
+            for (auto const &b : bindings)
+            {
+                ImGui::Text("%10.3f ms %8lu  %s", b.seconds * 1000.0, b.calls, b.name.c_str());
             }
         }
+
+        if (ImGui::CollapsingHeader("Lua Samples", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            // sampled functions ("source:line"), most samples first
+            typedef std::pair<std::string, unsigned long> Sample;
+            std::vector<Sample> samples(g_profiler.luaSamples().begin(), g_profiler.luaSamples().end());
+            std::sort(samples.begin(), samples.end(), [](Sample const &a, Sample const &b)
+                      { return a.second > b.second; });
+            double total = static_cast<double>(g_profiler.numLuaSamples());
+            for (std::size_t i = 0; i < samples.size() && i < 32; ++i)
+            {
+                ImGui::Text("%5.1f %%  %s", 100.0 * samples[i].second / total, samples[i].first.c_str());
+            }
+        }
+
+        ImGui::End();
     }
 } // namespace mygame
@@ -0,0 +1,47 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "ygif_hash.h"
+#include "ygif_mesh.h"
+
+// ygif_meshc: converts .obj files into the binary mesh format (.ygmesh),
+// loaded by yg.gl.loadGeometry() instead of the .obj, if present beside it.
+//
+// usage: ygif_meshc <in.obj> <out.ygmesh>
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::printf("usage: %s <in.obj> <out.ygmesh>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::printf("%s: failed to open\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::vector<char> src((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::vector<uint8_t> mesh;
+    std::string err;
+    uint64_t hash = src.empty() ? mygame::fnv1a64Basis : mygame::hashFnv1a64(&src[0], src.size());
+    if (src.empty() || !mygame::convertObjToMesh(&src[0], src.size(), hash, mesh, &err))
+    {
+        std::printf("%s: not converted: %s\n", argv[1], err.c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write(reinterpret_cast<char const *>(&mesh[0]), static_cast<std::streamsize>(mesh.size()));
+    if (!out)
+    {
+        std::printf("%s: failed to write\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "yourgame/yourgame.h"
+#include "ygif_async.h"
+#include "ygif_glue.h"
+#include "ygif_jobs.h"
+#include "ygif_runtime.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        std::mutex g_mutex;
+        std::condition_variable g_preparedCv;
+        std::deque<std::shared_ptr<AsyncLoad>> g_prepared; // ready to finish
+        unsigned g_generation = 0;                         // incremented by cancelAsyncLoads()
+
+        void prepareLoad(std::shared_ptr<AsyncLoad> const &load)
+        {
+            ResourceCache::prepare(load->req);
+            {
+                std::lock_guard<std::mutex> lock(g_mutex);
+                if (load->status != AsyncLoad::QUEUED)
+                {
+                    return; // prepared by a blocking get() already
+                }
+                load->status = AsyncLoad::PREPARED;
+                g_prepared.push_back(load);
+            }
+            g_preparedCv.notify_all();
+        }
+
+        LoadHandle submit(ResourceCache::Request req)
+        {
+            LoadHandle h;
+            h.load = std::make_shared<AsyncLoad>();
+            h.load->type = req.type;
+            h.load->req = std::move(req);
+            h.load->generation = g_generation;
+            std::shared_ptr<AsyncLoad> load = h.load;
+            getJobPool().submit([load]() { prepareLoad(load); });
+            return h;
+        }
+
+        // main thread
+        void finishLoad(AsyncLoad &load)
+        {
+            if (load.status == AsyncLoad::DONE)
+            {
+                return;
+            }
+            if (load.generation == g_generation)
+            {
+                load.ok = g_resources.acquire(load.req, load.resource);
+            }
+            // free the file data
+            load.req = ResourceCache::Request();
+            load.status = AsyncLoad::DONE;
+        }
+    }
+
+    bool LoadHandle::isReady() const
+    {
+        return load->status == AsyncLoad::DONE;
+    }
+
+    int LoadHandle::get(lua_State *L)
+    {
+        if (load->status != AsyncLoad::DONE)
+        {
+            std::unique_lock<std::mutex> lock(g_mutex);
+            if (getJobPool().numWorkers() == 0u && load->status == AsyncLoad::QUEUED)
+            {
+                // no workers: prepare here, the queued job becomes a no-op
+                ResourceCache::prepare(load->req);
+                load->status = AsyncLoad::PREPARED;
+            }
+            else
+            {
+                g_preparedCv.wait(lock, [this]() { return load->status != AsyncLoad::QUEUED; });
+            }
+            for (auto it = g_prepared.begin(); it != g_prepared.end(); ++it)
+            {
+                if (*it == load)
+                {
+                    g_prepared.erase(it);
+                    break;
+                }
+            }
+            lock.unlock();
+            finishLoad(*load);
+        }
+
+        if (!load->ok)
+        {
+            lua_pushnil(L);
+        }
+        else if (load->resource == nullptr)
+        {
+            lua_pushboolean(L, 1); // audio file
+        }
+        else if (!g_resources.isLive(load->resource))
+        {
+            return luaL_error(L, "LoadHandle:get(): resource was released");
+        }
+        else if (load->type == ResourceCache::Type::SHADER)
+        {
+            pushShader(L, static_cast<yg::gl::Shader *>(load->resource));
+        }
+        else
+        {
+            pushGeometry(L, static_cast<yg::gl::Geometry *>(load->resource));
+        }
+        return 1;
+    }
+
+    LoadHandle loadGeometryAsync(std::string const &filename)
+    {
+        return submit(ResourceCache::geometryRequest(filename));
+    }
+
+    LoadHandle loadVertFragShaderAsync(std::string const &vertFilename, std::string const &fragFilename)
+    {
+        return submit(ResourceCache::vertFragShaderRequest(vertFilename, fragFilename));
+    }
+
+    LoadHandle storeAudioFileAsync(std::string const &filename)
+    {
+        return submit(ResourceCache::audioFileRequest(filename));
+    }
+
+    void updateAsyncLoads(double budgetSeconds)
+    {
+        // without workers, the jobs run here
+        getJobPool().runPending(budgetSeconds);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (;;)
+        {
+            std::shared_ptr<AsyncLoad> load;
+            {
+                std::lock_guard<std::mutex> lock(g_mutex);
+                if (g_prepared.empty())
+                {
+                    return;
+                }
+                load = g_prepared.front();
+                g_prepared.pop_front();
+            }
+            finishLoad(*load);
+
+            if (std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() >= budgetSeconds)
+            {
+                return;
+            }
+        }
+    }
+
+    void cancelAsyncLoads()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ++g_generation;
+        g_prepared.clear();
+    }
+
+    std::shared_ptr<AsyncFileRead> readFileAsync(std::string const &filename)
+    {
+        std::shared_ptr<AsyncFileRead> read = std::make_shared<AsyncFileRead>();
+        getJobPool().submit([read, filename]() {
+            read->result = yg::file::readFile(filename, read->data);
+            read->done = true;
+        });
+        return read;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef YGIF_ASYNC_H
+#define YGIF_ASYNC_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ygif_resources.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // asynchronous resource loads into g_resources: file I/O, hashing and mesh
+    // conversion run on the job pool, acquiring (GL uploads, audio decoding)
+    // runs on the main thread in updateAsyncLoads()
+    struct AsyncLoad
+    {
+        enum Status
+        {
+            QUEUED,
+            PREPARED,
+            DONE
+        };
+
+        ResourceCache::Type type;
+        ResourceCache::Request req; // reset when done
+        std::atomic<int> status{QUEUED};
+        unsigned generation = 0;
+        bool ok = false;
+        void *resource = nullptr;
+    };
+
+    // Lua handle of an asynchronous load (yg.gl.LoadHandle), copies share the load
+    class LoadHandle
+    {
+    public:
+        bool isReady() const;
+
+        // pushes the Geometry or Shader, true for audio files, or nil if
+        // loading failed. finishes the load first, if it is not ready (blocking).
+        // raises an error if the resource was released (yg.gl.releaseGeometry())
+        int get(lua_State *L);
+
+        std::shared_ptr<AsyncLoad> load;
+    };
+
+    LoadHandle loadGeometryAsync(std::string const &filename);
+    LoadHandle loadVertFragShaderAsync(std::string const &vertFilename, std::string const &fragFilename);
+    LoadHandle storeAudioFileAsync(std::string const &filename);
+
+    // main thread, once per frame: finishes prepared loads until budgetSeconds
+    // are used (at least one)
+    void updateAsyncLoads(double budgetSeconds);
+
+    // drops pending loads, called when the Lua state that requested them closes
+    void cancelAsyncLoads();
+
+    // yg::file::readFile() on the job pool
+    struct AsyncFileRead
+    {
+        std::atomic<bool> done{false};
+        int result = -1; // of yg::file::readFile()
+        std::vector<uint8_t> data;
+    };
+
+    std::shared_ptr<AsyncFileRead> readFileAsync(std::string const &filename);
+}
+
+#endif
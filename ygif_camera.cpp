@@ -1,4 +1,10 @@
 #include "ygif_camera.h"
+#include "ygif_vecmath.h"
+
+extern "C"
+{
+#include "lauxlib.h"
+}
 
 namespace mygame
 {
@@ -13,4 +19,15 @@ namespace mygame
         yourgame::math::Camera::castRay(viewportX, viewportY, org, dir);
         return std::array<float, 6>{org.x, org.y, org.z, dir.x, dir.y, dir.z};
     }
+
+    int YgifCamera::castRayInto(lua_State *L)
+    {
+        glm::vec3 org, dir;
+        yourgame::math::Camera::castRay(static_cast<float>(luaL_checknumber(L, 2)),
+                                        static_cast<float>(luaL_checknumber(L, 3)),
+                                        org, dir);
+        writeVec3(L, 4, org);
+        writeVec3(L, 5, dir);
+        return 0;
+    }
 }
@@ -12,6 +12,10 @@ namespace mygame
     public:
         YgifTrafo *trafo();
         std::array<float, 6> castRay(float viewportX, float viewportY);
+
+        // camera:castRayInto(viewportX, viewportY, org, dir), writes into
+        // existing yg.math.Vec3s or tables (lua_CFunction member)
+        int castRayInto(lua_State *L);
     };
 }
 
@@ -0,0 +1,77 @@
+#include <cmath>
+#include <unordered_map>
+#include "ygif_culling.h"
+
+namespace mygame
+{
+    bool g_frustumCulling = true;
+
+    namespace
+    {
+        std::unordered_map<yourgame::gl::Geometry const *, Bounds> g_geometryBounds;
+    }
+
+    Bounds transformBounds(Bounds const &b, glm::mat4 const &m)
+    {
+        // center and extents
+        glm::vec3 c = glm::vec3(m * glm::vec4((b.min + b.max) * 0.5f, 1.0f));
+        glm::vec3 e = (b.max - b.min) * 0.5f;
+        glm::vec3 we;
+        for (int i = 0; i < 3; ++i)
+        {
+            we[i] = std::fabs(m[0][i]) * e.x + std::fabs(m[1][i]) * e.y + std::fabs(m[2][i]) * e.z;
+        }
+        return {c - we, c + we};
+    }
+
+    Frustum::Frustum(yourgame::math::Camera *camera)
+    {
+        // rows of the (column-major) view-projection matrix, Gribb/Hartmann
+        glm::mat4 m = camera->pMat() * camera->vMat();
+        glm::vec4 rows[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+        }
+        planes[0] = rows[3] + rows[0]; // left
+        planes[1] = rows[3] - rows[0]; // right
+        planes[2] = rows[3] + rows[1]; // bottom
+        planes[3] = rows[3] - rows[1]; // top
+        planes[4] = rows[3] + rows[2]; // near
+        planes[5] = rows[3] - rows[2]; // far
+    }
+
+    bool Frustum::intersects(Bounds const &b, glm::mat4 const &modelMat) const
+    {
+        Bounds wb = transformBounds(b, modelMat);
+        glm::vec3 c = (wb.min + wb.max) * 0.5f;
+        glm::vec3 we = (wb.max - wb.min) * 0.5f;
+
+        for (auto const &p : planes)
+        {
+            float dist = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+            float radius = std::fabs(p.x) * we.x + std::fabs(p.y) * we.y + std::fabs(p.z) * we.z;
+            if (dist + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void setGeometryBounds(yourgame::gl::Geometry const *geo, Bounds const &b)
+    {
+        g_geometryBounds[geo] = b;
+    }
+
+    void clearGeometryBounds(yourgame::gl::Geometry const *geo)
+    {
+        g_geometryBounds.erase(geo);
+    }
+
+    Bounds const *getGeometryBounds(yourgame::gl::Geometry const *geo)
+    {
+        auto it = g_geometryBounds.find(geo);
+        return (it != g_geometryBounds.end()) ? &it->second : nullptr;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef YGIF_CULLING_H
+#define YGIF_CULLING_H
+
+#include "yourgame/yourgame.h"
+
+namespace mygame
+{
+    // axis-aligned bounding box in model space
+    struct Bounds
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // world-space AABB of b transformed by m
+    Bounds transformBounds(Bounds const &b, glm::mat4 const &m);
+
+    // view frustum of a camera: 6 planes (not normalized) with the inside
+    // on the positive side, extracted from the view-projection matrix
+    struct Frustum
+    {
+        glm::vec4 planes[6];
+
+        explicit Frustum(yourgame::math::Camera *camera);
+
+        // false if the box b, transformed by modelMat, is outside of a plane.
+        // conservative: the transformed box is bounded by a world-space AABB
+        bool intersects(Bounds const &b, glm::mat4 const &modelMat) const;
+    };
+
+    // model-space bounds of geometries, set by the resource cache at load
+    // time. geometries without bounds are never culled
+    void setGeometryBounds(yourgame::gl::Geometry const *geo, Bounds const &b);
+    void clearGeometryBounds(yourgame::gl::Geometry const *geo);
+    Bounds const *getGeometryBounds(yourgame::gl::Geometry const *geo);
+
+    // frustum culling of gl_draw() and DrawList, on by default
+    extern bool g_frustumCulling;
+}
+
+#endif
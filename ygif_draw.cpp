@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <memory>
+#include "ygif_draw.h"
+#include "ygif_host.h"
+#include "ygif_profiler.h"
+#include "ygif_culling.h"
+#include "ygif_runtime.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    int DrawList::add(lua_State *L)
+    {
+        yg::gl::Geometry *geo = luabridge::Stack<yg::gl::Geometry *>::get(L, 2);
+        yg::gl::Shader *shader = luabridge::Stack<yg::gl::Shader *>::get(L, 3);
+        yg::gl::Lightsource *light = luabridge::Stack<yg::gl::Lightsource *>::get(L, 4);
+        yg::math::Trafo *trafo = luabridge::Stack<yg::math::Trafo *>::get(L, 5);
+        if (geo == nullptr || shader == nullptr)
+        {
+            return 0;
+        }
+        // lights are tracked by identity (g_glState), so they are anchored,
+        // not copied
+        if (light != nullptr)
+        {
+            anchor(L, 4, light);
+        }
+        Entry e;
+        e.shader = shader;
+        e.light = light;
+        e.geo = geo;
+        e.modelMat = (trafo != nullptr) ? trafo->mat() : glm::mat4(1.0f);
+        m_entries.push_back(e);
+        return 0;
+    }
+
+    DrawList::~DrawList()
+    {
+        unanchorAll();
+    }
+
+    int DrawList::addPool(lua_State *L)
+    {
+        yg::gl::Geometry *geo = luabridge::Stack<yg::gl::Geometry *>::get(L, 2);
+        yg::gl::Shader *shader = luabridge::Stack<yg::gl::Shader *>::get(L, 3);
+        yg::gl::Lightsource *light = luabridge::Stack<yg::gl::Lightsource *>::get(L, 4);
+        TrafoPool *pool = luabridge::Stack<TrafoPool *>::get(L, 5);
+        if (geo == nullptr || shader == nullptr || pool == nullptr || pool->size() == 0)
+        {
+            return 0;
+        }
+        anchor(L, 5, pool);
+        if (light != nullptr)
+        {
+            anchor(L, 4, light);
+        }
+        m_pools.push_back({shader, light, geo, pool});
+        return 0;
+    }
+
+    void DrawList::setInstancedShader(yg::gl::Shader *shader, yg::gl::Shader *instancedShader)
+    {
+        if (instancedShader == nullptr)
+        {
+            m_instancedShaders.erase(shader);
+        }
+        else
+        {
+            m_instancedShaders[shader] = instancedShader;
+        }
+    }
+
+    void DrawList::flush(yg::math::Camera *camera)
+    {
+        ProfileScope scope(Profiler::SECTION_DRAW);
+
+        if (m_resourceFrees != g_resources.frees())
+        {
+            dropReleased();
+            m_resourceFrees = g_resources.frees();
+        }
+
+        // frustum culling: drop invisible entries before sorting
+        std::unique_ptr<Frustum> frustum;
+        if (g_frustumCulling && camera != nullptr)
+        {
+            frustum.reset(new Frustum(camera));
+            std::size_t numEntries = m_entries.size();
+            m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [&frustum](const Entry &e)
+                                           {
+                                               Bounds const *b = getGeometryBounds(e.geo);
+                                               return b != nullptr && !frustum->intersects(*b, e.modelMat);
+                                           }),
+                            m_entries.end());
+            g_profiler.countDraws(0, static_cast<int>(numEntries - m_entries.size()));
+        }
+        g_profiler.countDraws(static_cast<int>(m_entries.size()), 0);
+
+        std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b)
+                  {
+                      if (a.shader != b.shader)
+                      {
+                          return a.shader < b.shader;
+                      }
+                      if (a.light != b.light)
+                      {
+                          return a.light < b.light;
+                      }
+                      return a.geo < b.geo;
+                  });
+
+        yg::gl::DrawConfig cfg;
+        cfg.camera = camera;
+
+        std::size_t i = 0;
+        while (i < m_entries.size())
+        {
+            // group: same shader and light
+            std::size_t groupEnd = i;
+            while (groupEnd < m_entries.size() &&
+                   m_entries[groupEnd].shader == m_entries[i].shader &&
+                   m_entries[groupEnd].light == m_entries[i].light)
+            {
+                ++groupEnd;
+            }
+
+            auto inst = m_instancedShaders.find(m_entries[i].shader);
+            yg::gl::Shader *boundShader = nullptr;
+
+            while (i < groupEnd)
+            {
+                // run: same geometry within group
+                std::size_t runEnd = i;
+                while (runEnd < groupEnd && m_entries[runEnd].geo == m_entries[i].geo)
+                {
+                    ++runEnd;
+                }
+
+                if (inst != m_instancedShaders.end() && (runEnd - i) > 1)
+                {
+                    if (boundShader != inst->second)
+                    {
+                        host::useProgram(inst->second, m_entries[i].light, camera);
+                        boundShader = inst->second;
+                    }
+
+                    cfg.shader = inst->second;
+                    cfg.modelMat = glm::mat4(1.0f);
+                    for (std::size_t k = i; k < runEnd; k += maxInstancesPerDraw)
+                    {
+                        std::size_t n = std::min(runEnd - k, static_cast<std::size_t>(maxInstancesPerDraw));
+                        m_instanceMats.clear();
+                        for (std::size_t j = k; j < k + n; ++j)
+                        {
+                            m_instanceMats.push_back(m_entries[j].modelMat);
+                        }
+                        host::uploadInstanceModelMats(inst->second, &(m_instanceMats[0]), static_cast<int>(n));
+                        cfg.instancecount = static_cast<int>(n);
+                        host::drawGeo(m_entries[i].geo, cfg);
+                    }
+                    cfg.instancecount = 0;
+                }
+                else
+                {
+                    if (boundShader != m_entries[i].shader)
+                    {
+                        host::useProgram(m_entries[i].shader, m_entries[i].light, camera);
+                        boundShader = m_entries[i].shader;
+                    }
+                    cfg.shader = m_entries[i].shader;
+                    for (std::size_t j = i; j < runEnd; ++j)
+                    {
+                        cfg.modelMat = m_entries[j].modelMat;
+                        host::drawGeo(m_entries[j].geo, cfg);
+                    }
+                }
+
+                i = runEnd;
+            }
+        }
+
+        for (auto const &e : m_pools)
+        {
+            flushPool(e, camera, frustum.get());
+        }
+
+        clear();
+    }
+
+    // resources were freed since the last flush: drop the entries and
+    // instanced variants that use one of them
+    void DrawList::dropReleased()
+    {
+        auto released = [](void const *resource) {
+            return !g_resources.isLive(resource);
+        };
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [&released](Entry const &e)
+                                       { return released(e.geo) || released(e.shader); }),
+                        m_entries.end());
+        m_pools.erase(std::remove_if(m_pools.begin(), m_pools.end(), [&released](PoolEntry const &e)
+                                     { return released(e.geo) || released(e.shader); }),
+                      m_pools.end());
+        for (auto it = m_instancedShaders.begin(); it != m_instancedShaders.end();)
+        {
+            if (released(it->first) || released(it->second))
+            {
+                it = m_instancedShaders.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void DrawList::flushPool(PoolEntry const &e, yg::math::Camera *camera, Frustum const *frustum)
+    {
+        glm::mat4 const *mats = e.pool->matrices();
+        int n = e.pool->size();
+
+        // culled: visible matrices are copied. otherwise the matrices are
+        // drawn from the pool, without copying
+        Bounds const *bounds = (frustum != nullptr) ? getGeometryBounds(e.geo) : nullptr;
+        if (bounds != nullptr)
+        {
+            m_instanceMats.clear();
+            for (int k = 0; k < n; ++k)
+            {
+                if (frustum->intersects(*bounds, mats[k]))
+                {
+                    m_instanceMats.push_back(mats[k]);
+                }
+            }
+            g_profiler.countDraws(0, n - static_cast<int>(m_instanceMats.size()));
+            mats = m_instanceMats.empty() ? nullptr : &m_instanceMats[0];
+            n = static_cast<int>(m_instanceMats.size());
+        }
+        g_profiler.countDraws(n, 0);
+        if (n == 0)
+        {
+            return;
+        }
+
+        yg::gl::DrawConfig cfg;
+        cfg.camera = camera;
+
+        auto inst = m_instancedShaders.find(e.shader);
+        if (inst != m_instancedShaders.end())
+        {
+            host::useProgram(inst->second, e.light, camera);
+            cfg.shader = inst->second;
+            cfg.modelMat = glm::mat4(1.0f);
+            for (int k = 0; k < n; k += maxInstancesPerDraw)
+            {
+                int count = std::min(n - k, maxInstancesPerDraw);
+                host::uploadInstanceModelMats(inst->second, mats + k, count);
+                cfg.instancecount = count;
+                host::drawGeo(e.geo, cfg);
+            }
+        }
+        else
+        {
+            host::useProgram(e.shader, e.light, camera);
+            cfg.shader = e.shader;
+            for (int k = 0; k < n; ++k)
+            {
+                cfg.modelMat = mats[k];
+                host::drawGeo(e.geo, cfg);
+            }
+        }
+    }
+
+    void DrawList::clear()
+    {
+        // keeps capacity, the list is refilled every frame
+        m_entries.clear();
+        m_pools.clear();
+        unanchorAll();
+    }
+
+    int DrawList::size() const
+    {
+        return static_cast<int>(m_entries.size() + m_pools.size());
+    }
+
+    // a few values per list (pools, lights): linear search
+    void DrawList::anchor(lua_State *L, int idx, void const *ptr)
+    {
+        for (auto const &a : m_anchors)
+        {
+            if (a.first == ptr)
+            {
+                return;
+            }
+        }
+        if (m_L == nullptr)
+        {
+            m_L = luaMainThread(L);
+        }
+        lua_pushvalue(L, idx);
+        m_anchors.push_back({ptr, luaL_ref(L, LUA_REGISTRYINDEX)});
+    }
+
+    void DrawList::unanchorAll()
+    {
+        for (auto const &a : m_anchors)
+        {
+            luaL_unref(m_L, LUA_REGISTRYINDEX, a.second);
+        }
+        m_anchors.clear();
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef YGIF_DRAW_H
+#define YGIF_DRAW_H
+
+#include <map>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_trafopool.h"
+#include "ygif_culling.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // collects draw calls during tick() and submits them in flush(),
+    // sorted by shader, light and geometry. state (program, camera and
+    // light uniforms) is bound once per group. if an instanced variant is set
+    // for a shader, repeated geometry is drawn instanced.
+    class DrawList
+    {
+    public:
+        // has to match the instModelMats[]/instNormalMats[] array sizes in
+        // default_instanced.vert
+        static const int maxInstancesPerDraw = 32;
+
+        DrawList() = default;
+        DrawList(DrawList const &) = delete;
+        DrawList &operator=(DrawList const &) = delete;
+        ~DrawList();
+
+        // lua_CFunction: dl:add(geo, shader, light, trafo). trafo may be nil
+        // (identity), the model matrix is copied. the list keeps light alive
+        // until flush() or clear()
+        int add(lua_State *L);
+
+        // lua_CFunction: dl:addPool(geo, shader, light, pool) adds geo for
+        // every element of pool, drawn instanced from the matrices of pool if
+        // an instanced variant of shader is set (straight from the pool if geo
+        // has no bounds or culling is off). the list keeps pool and light
+        // alive until flush() or clear()
+        int addPool(lua_State *L);
+
+        // draws geometry submitted with shader instanced, using instancedShader
+        void setInstancedShader(yourgame::gl::Shader *shader, yourgame::gl::Shader *instancedShader);
+
+        // draws all entries from the view of camera, then clears the list.
+        // lights are evaluated at flush time. entries outside of the camera
+        // frustum are skipped (g_frustumCulling), as are entries of geometries
+        // and shaders released since they were added
+        void flush(yourgame::math::Camera *camera);
+
+        void clear();
+        int size() const; // a pool counts once
+
+    private:
+        struct Entry
+        {
+            yourgame::gl::Shader *shader;
+            yourgame::gl::Lightsource *light;
+            yourgame::gl::Geometry *geo;
+            glm::mat4 modelMat;
+        };
+
+        struct PoolEntry
+        {
+            yourgame::gl::Shader *shader;
+            yourgame::gl::Lightsource *light;
+            yourgame::gl::Geometry *geo;
+            TrafoPool *pool;
+        };
+
+        void flushPool(PoolEntry const &e, yourgame::math::Camera *camera, Frustum const *frustum);
+        void dropReleased();
+
+        // keeps the Lua value at idx (owning ptr) alive until clear()
+        void anchor(lua_State *L, int idx, void const *ptr);
+        void unanchorAll();
+
+        std::vector<Entry> m_entries;
+        std::vector<PoolEntry> m_pools;
+        std::vector<glm::mat4> m_instanceMats;
+        std::map<yourgame::gl::Shader *, yourgame::gl::Shader *> m_instancedShaders;
+        unsigned long m_resourceFrees = 0; // g_resources.frees() at the last flush
+
+        lua_State *m_L = nullptr; // main thread, for the anchors
+        std::vector<std::pair<void const *, int>> m_anchors; // pointer, registry ref
+    };
+}
+
+#endif
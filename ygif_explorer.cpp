@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cctype>
+#include "ygif_explorer.h"
+
+namespace mygame
+{
+    namespace
+    {
+        char lower(char c)
+        {
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        uint32_t trigram(char const *s)
+        {
+            return (static_cast<uint32_t>(static_cast<unsigned char>(lower(s[0]))) << 16) |
+                   (static_cast<uint32_t>(static_cast<unsigned char>(lower(s[1]))) << 8) |
+                   static_cast<uint32_t>(static_cast<unsigned char>(lower(s[2])));
+        }
+
+        // filter (lower case) is a subsequence of str
+        bool isSubsequence(std::string const &filter, std::string const &str)
+        {
+            std::size_t k = 0;
+            for (std::size_t i = 0; i < str.size() && k < filter.size(); ++i)
+            {
+                if (lower(str[i]) == filter[k])
+                {
+                    ++k;
+                }
+            }
+            return k == filter.size();
+        }
+    }
+
+    ExplorerTree::ExplorerTree(std::string const &root, std::set<std::string> const &exclude)
+        : m_root(root), m_exclude(exclude)
+    {
+        Folder &f = m_folders[""];
+        f.index.reset(new FileIndex(root));
+        f.expanded = true;
+    }
+
+    void ExplorerTree::update(double now)
+    {
+        bool changed = false;
+        for (auto &f : m_folders)
+        {
+            f.second.index->update(now);
+            if (f.second.index->generation() != f.second.generation)
+            {
+                f.second.generation = f.second.index->generation();
+                changed = true;
+            }
+        }
+        if (changed)
+        {
+            rebuildEntries();
+            rebuildRows();
+        }
+    }
+
+    std::vector<int> const &ExplorerTree::rows() const
+    {
+        return m_rows;
+    }
+
+    ExplorerTree::Entry const &ExplorerTree::entry(int i) const
+    {
+        return m_entries[i];
+    }
+
+    bool ExplorerTree::isExpanded(int i) const
+    {
+        auto it = m_folders.find(m_entries[i].path);
+        return it != m_folders.end() && it->second.expanded;
+    }
+
+    void ExplorerTree::setExpanded(int i, bool expanded)
+    {
+        Entry const &e = m_entries[i];
+        if (!e.isDir || isExpanded(i) == expanded)
+        {
+            return;
+        }
+
+        // first expansion: listed in the next update()
+        Folder &f = m_folders[e.path];
+        if (!f.index)
+        {
+            f.index.reset(new FileIndex(m_root + e.path));
+        }
+        f.expanded = expanded;
+        rebuildRows();
+    }
+
+    void ExplorerTree::setFilter(std::string const &filter)
+    {
+        std::string f(filter.size(), ' ');
+        std::transform(filter.begin(), filter.end(), f.begin(), lower);
+        if (f != m_filter)
+        {
+            m_filter.swap(f);
+            rebuildRows();
+        }
+    }
+
+    bool ExplorerTree::isFiltered() const
+    {
+        return !m_filter.empty();
+    }
+
+    FileIndex const &ExplorerTree::rootIndex() const
+    {
+        return *(m_folders.at("").index);
+    }
+
+    std::vector<std::string> ExplorerTree::takeChanged()
+    {
+        std::vector<std::string> changed;
+        for (auto &f : m_folders)
+        {
+            std::vector<std::string> c = f.second.index->takeChanged();
+            changed.insert(changed.end(), c.begin(), c.end());
+        }
+        return changed;
+    }
+
+    void ExplorerTree::rebuildEntries()
+    {
+        m_entries.clear();
+        m_children.clear();
+        addEntries("", 0);
+
+        m_trigrams.clear();
+        for (int i = 0; i < static_cast<int>(m_entries.size()); ++i)
+        {
+            std::string const &p = m_entries[i].path;
+            if (m_entries[i].isDir)
+            {
+                continue;
+            }
+            for (std::size_t k = 0; k + 3 <= p.size(); ++k)
+            {
+                std::vector<int> &postings = m_trigrams[trigram(&p[k])];
+                if (postings.empty() || postings.back() != i)
+                {
+                    postings.push_back(i);
+                }
+            }
+        }
+        m_counts.assign(m_entries.size(), 0);
+    }
+
+    // entries of the folder at path, depth-first
+    void ExplorerTree::addEntries(std::string const &path, int depth)
+    {
+        auto folder = m_folders.find(path);
+        if (folder == m_folders.end())
+        {
+            return;
+        }
+
+        for (auto const &name : folder->second.index->files())
+        {
+            if (name == "./" || name == "../" || m_exclude.find(name) != m_exclude.end())
+            {
+                continue;
+            }
+
+            Entry e;
+            e.path = path + name;
+            e.file = m_root + e.path;
+            e.name = name;
+            e.txtLabel = "txt##" + e.file;
+            e.binLabel = "bin##" + e.file;
+            e.isDir = (name.back() == '/');
+            e.depth = depth;
+            m_children[path].push_back(static_cast<int>(m_entries.size()));
+            m_entries.push_back(e);
+
+            if (e.isDir)
+            {
+                addEntries(e.path, depth + 1);
+            }
+        }
+    }
+
+    void ExplorerTree::rebuildRows()
+    {
+        m_rows.clear();
+        if (m_filter.empty())
+        {
+            addRows("");
+            return;
+        }
+
+        if (m_filter.size() < 3)
+        {
+            for (int i = 0; i < static_cast<int>(m_entries.size()); ++i)
+            {
+                if (!m_entries[i].isDir && isSubsequence(m_filter, m_entries[i].path))
+                {
+                    m_rows.push_back(i);
+                }
+            }
+            return;
+        }
+
+        // count the distinct trigrams of the filter per entry
+        std::vector<uint32_t> tris;
+        for (std::size_t k = 0; k + 3 <= m_filter.size(); ++k)
+        {
+            tris.push_back(trigram(&m_filter[k]));
+        }
+        std::sort(tris.begin(), tris.end());
+        tris.erase(std::unique(tris.begin(), tris.end()), tris.end());
+
+        std::vector<int> touched;
+        for (uint32_t t : tris)
+        {
+            auto it = m_trigrams.find(t);
+            if (it == m_trigrams.end())
+            {
+                continue;
+            }
+            for (int i : it->second)
+            {
+                if (m_counts[i]++ == 0)
+                {
+                    touched.push_back(i);
+                }
+            }
+        }
+
+        int minCount = static_cast<int>((tris.size() + 1) / 2);
+        for (int i : touched)
+        {
+            if (m_counts[i] >= minCount)
+            {
+                m_rows.push_back(i);
+            }
+        }
+
+        // best matches first, tree order otherwise
+        std::sort(m_rows.begin(), m_rows.end(), [this](int a, int b)
+                  { return (m_counts[a] != m_counts[b]) ? (m_counts[a] > m_counts[b]) : (a < b); });
+        for (int i : touched)
+        {
+            m_counts[i] = 0;
+        }
+    }
+
+    // rows of the folder at path, and of its expanded subfolders
+    void ExplorerTree::addRows(std::string const &path)
+    {
+        auto children = m_children.find(path);
+        if (children == m_children.end())
+        {
+            return;
+        }
+        for (int i : children->second)
+        {
+            m_rows.push_back(i);
+            if (m_entries[i].isDir && isExpanded(i))
+            {
+                addRows(m_entries[i].path);
+            }
+        }
+    }
+}
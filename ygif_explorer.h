@@ -0,0 +1,88 @@
+#ifndef YGIF_EXPLORER_H
+#define YGIF_EXPLORER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ygif_fileindex.h"
+
+namespace mygame
+{
+    // content of an Explorer section ("a//" or "p//"), for rendering only
+    // the visible rows: a folder tree over FileIndexes (a folder is listed
+    // when it is expanded the first time, and kept up to date from then on).
+    // entries, with their widget labels, and the rows are built when a
+    // listing changes, not per frame.
+    // with a filter set, the rows are the files of all listed folders that
+    // match it fuzzily: at least half of the trigrams of the filter occur in
+    // the path (looked up in a trigram index), or, for filters shorter than
+    // 3 characters, the filter is a subsequence of the path.
+    class ExplorerTree
+    {
+    public:
+        struct Entry
+        {
+            std::string file;     // yg::file path, "p//dir/x.lua"
+            std::string path;     // relative to the root, "dir/x.lua" or "dir/"
+            std::string name;     // "x.lua" or "dir/"
+            std::string txtLabel; // "txt##p//dir/x.lua", expand button of folders
+            std::string binLabel; // "bin##p//dir/x.lua"
+            bool isDir;
+            int depth;
+        };
+
+        ExplorerTree(std::string const &root, std::set<std::string> const &exclude);
+
+        // updates the listings (main thread, once per frame), rebuilds the
+        // entries and rows if one changed
+        void update(double now);
+
+        // entry indices of the rows to show
+        std::vector<int> const &rows() const;
+        Entry const &entry(int i) const;
+
+        bool isExpanded(int i) const;
+        void setExpanded(int i, bool expanded);
+
+        // case-insensitive, "" for the tree
+        void setFilter(std::string const &filter);
+        bool isFiltered() const;
+
+        // the listing of the root folder
+        FileIndex const &rootIndex() const;
+
+        // yg::file paths of the files created or written in any listed folder
+        // since the last call, see FileIndex::takeChanged()
+        std::vector<std::string> takeChanged();
+
+    private:
+        struct Folder
+        {
+            std::unique_ptr<FileIndex> index;
+            uint64_t generation = 0;
+            bool expanded = false;
+        };
+
+        void rebuildEntries();
+        void addEntries(std::string const &path, int depth);
+        void rebuildRows();
+        void addRows(std::string const &path);
+
+        std::string m_root;
+        std::set<std::string> m_exclude;
+        std::map<std::string, Folder> m_folders; // by path, "" for the root
+        std::vector<Entry> m_entries;             // tree order
+        std::unordered_map<std::string, std::vector<int>> m_children; // folder path -> entries
+        std::vector<int> m_rows;
+
+        std::string m_filter;
+        std::unordered_map<uint32_t, std::vector<int>> m_trigrams; // -> file entries, ascending
+        std::vector<int> m_counts; // per entry, filter scratch
+    };
+}
+
+#endif
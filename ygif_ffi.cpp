@@ -0,0 +1,280 @@
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "yourgame/yourgame.h"
+#include "ygif_ffi.h"
+#include "ygif_host.h"
+#include "ygif_input.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+namespace yg = yourgame; // convenience
+
+#define YGIF_FFI_STR_(...) #__VA_ARGS__
+#define YGIF_FFI_STR(...) YGIF_FFI_STR_(__VA_ARGS__)
+#define YGIF_FFI_CDEF_FIELD(ret, name, params) #ret " (*" #name ")" #params ";\n"
+
+namespace mygame
+{
+    namespace
+    {
+        yg::math::Trafo *trafo(ygif_Trafo *t)
+        {
+            return reinterpret_cast<yg::math::Trafo *>(t);
+        }
+
+        glm::vec3 vec3(ygif_vec3 const *v)
+        {
+            return glm::vec3(v->x, v->y, v->z);
+        }
+
+        void setVec3(ygif_vec3 *out, glm::vec3 const &v)
+        {
+            out->x = v.x;
+            out->y = v.y;
+            out->z = v.z;
+        }
+
+        // normalized (ax, ay, az), false for the zero vector
+        bool toAxisVec(float ax, float ay, float az, glm::vec3 &v)
+        {
+            v = glm::vec3(ax, ay, az);
+            if (!(glm::length(v) > 0.0f))
+            {
+                return false;
+            }
+            v = glm::normalize(v);
+            return true;
+        }
+
+        yg::math::Axis toAxis(int axis)
+        {
+            return (axis == 1) ? yg::math::Axis::Y : ((axis == 2) ? yg::math::Axis::Z : yg::math::Axis::X);
+        }
+
+        void ffi_trafo_translateLocal(ygif_Trafo *t, float x, float y, float z)
+        {
+            trafo(t)->translateLocal(glm::vec3(x, y, z));
+        }
+
+        void ffi_trafo_translateGlobal(ygif_Trafo *t, float x, float y, float z)
+        {
+            trafo(t)->translateGlobal(glm::vec3(x, y, z));
+        }
+
+        void ffi_trafo_setTranslation(ygif_Trafo *t, float x, float y, float z)
+        {
+            trafo(t)->setTranslation(glm::vec3(x, y, z));
+        }
+
+        void ffi_trafo_setScaleLocal(ygif_Trafo *t, float x, float y, float z)
+        {
+            trafo(t)->setScaleLocal(glm::vec3(x, y, z));
+        }
+
+        void ffi_trafo_rotateLocal(ygif_Trafo *t, float angle, float ax, float ay, float az)
+        {
+            glm::vec3 v;
+            if (toAxisVec(ax, ay, az, v))
+            {
+                trafo(t)->rotateLocal(angle, v);
+            }
+        }
+
+        void ffi_trafo_rotateGlobal(ygif_Trafo *t, float angle, float ax, float ay, float az)
+        {
+            glm::vec3 v;
+            if (toAxisVec(ax, ay, az, v))
+            {
+                trafo(t)->rotateGlobal(angle, v);
+            }
+        }
+
+        void ffi_trafo_rotateLocalAxis(ygif_Trafo *t, float angle, int axis)
+        {
+            trafo(t)->rotateLocal(angle, toAxis(axis));
+        }
+
+        void ffi_trafo_rotateGlobalAxis(ygif_Trafo *t, float angle, int axis)
+        {
+            trafo(t)->rotateGlobal(angle, toAxis(axis));
+        }
+
+        // as YgifTrafo::rotateEuler()
+        void ffi_trafo_rotateEuler(ygif_Trafo *t, float x, float y, float z)
+        {
+            if (x != 0.0f)
+            {
+                trafo(t)->rotateLocal(x, yg::math::Axis::X);
+            }
+            if (y != 0.0f)
+            {
+                trafo(t)->rotateLocal(y, yg::math::Axis::Y);
+            }
+            if (z != 0.0f)
+            {
+                trafo(t)->rotateLocal(z, yg::math::Axis::Z);
+            }
+        }
+
+        void ffi_trafo_getEye(ygif_Trafo *t, ygif_vec3 *out)
+        {
+            setVec3(out, trafo(t)->getEye());
+        }
+
+        void ffi_trafo_getScale(ygif_Trafo *t, ygif_vec3 *out)
+        {
+            setVec3(out, trafo(t)->getScale());
+        }
+
+        void ffi_trafo_getAxisLocal(ygif_Trafo *t, int axis, ygif_vec3 *out)
+        {
+            setVec3(out, trafo(t)->getAxisLocal(toAxis(axis)));
+        }
+
+        void ffi_trafo_getAxisGlobal(ygif_Trafo *t, int axis, ygif_vec3 *out)
+        {
+            setVec3(out, trafo(t)->getAxisGlobal(toAxis(axis)));
+        }
+
+        void ffi_trafo_transformPoint(ygif_Trafo *t, ygif_vec3 const *in, ygif_vec3 *out)
+        {
+            setVec3(out, glm::vec3(trafo(t)->mat() * glm::vec4(vec3(in), 1.0f)));
+        }
+
+        void ffi_vec3_rotate(ygif_vec3 *v, float angle, float ax, float ay, float az)
+        {
+            glm::vec3 axis;
+            if (toAxisVec(ax, ay, az, axis))
+            {
+                setVec3(v, glm::angleAxis(angle, axis) * vec3(v));
+            }
+        }
+
+        float ffi_input_get(int source)
+        {
+            yg::input::Source src;
+            return toInputSource(source, src) ? host::inputGet(src) : 0.0f;
+        }
+
+        int ffi_input_geti(int source)
+        {
+            yg::input::Source src;
+            return toInputSource(source, src) ? host::inputGeti(src) : 0;
+        }
+
+        float ffi_input_getDelta(int source)
+        {
+            yg::input::Source src;
+            return toInputSource(source, src) ? host::inputGetDelta(src) : 0.0f;
+        }
+
+        double ffi_time_getDelta()
+        {
+            return host::timeGetDelta();
+        }
+
+        double ffi_time_getTime()
+        {
+            return host::timeGetTime();
+        }
+
+#define YGIF_FFI_ENTRY(ret, name, params) ffi_##name,
+        ygif_api const g_ffiApi = {YGIF_FFI_FUNCTIONS(YGIF_FFI_ENTRY)};
+#undef YGIF_FFI_ENTRY
+
+        char const *const g_ffiCdef =
+            YGIF_FFI_STR(YGIF_FFI_TYPES) "\n"
+            "typedef struct ygif_api {\n" YGIF_FFI_FUNCTIONS(YGIF_FFI_CDEF_FIELD) "} ygif_api;\n";
+
+#if defined(YGIF_LUAJIT)
+        // yg.ffi.trafo(t): pointer to the yg::math::Trafo of a yg.math.Trafo,
+        // as light userdata (cast by the Lua side)
+        int ffi_trafoPointer(lua_State *L)
+        {
+            lua_pushlightuserdata(L, luabridge::Stack<yg::math::Trafo *>::get(L, 1));
+            return 1;
+        }
+
+        // Lua side of yg.ffi, called with the cdef, the function table and
+        // ffi_trafoPointer(). ygif_vec3 gets arithmetic and methods via
+        // ffi.metatype(), compiled into the traces of the script
+        char const *const ffiChunk = R"lua(
+local cdef, apiPtr, trafoPointer = ...
+local ffi = require("ffi")
+ffi.cdef(cdef)
+
+local vec3
+local vec3Methods = {
+    set = function(a, x, y, z) a.x, a.y, a.z = x, y, z; return a end,
+    dot = function(a, b) return a.x * b.x + a.y * b.y + a.z * b.z end,
+    cross = function(a, b) return vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x) end,
+    length = function(a) return math.sqrt(a.x * a.x + a.y * a.y + a.z * a.z) end,
+    normalize = function(a)
+        local l = math.sqrt(a.x * a.x + a.y * a.y + a.z * a.z)
+        return (l > 0) and vec3(a.x / l, a.y / l, a.z / l) or vec3(0, 0, 0)
+    end,
+}
+vec3 = ffi.metatype("ygif_vec3", {
+    __add = function(a, b) return vec3(a.x + b.x, a.y + b.y, a.z + b.z) end,
+    __sub = function(a, b) return vec3(a.x - b.x, a.y - b.y, a.z - b.z) end,
+    __mul = function(a, b)
+        if type(a) == "number" then return vec3(a * b.x, a * b.y, a * b.z) end
+        if type(b) == "number" then return vec3(a.x * b, a.y * b, a.z * b) end
+        return vec3(a.x * b.x, a.y * b.y, a.z * b.z)
+    end,
+    __unm = function(a) return vec3(-a.x, -a.y, -a.z) end,
+    __tostring = function(a) return string.format("(%g, %g, %g)", a.x, a.y, a.z) end,
+    __index = vec3Methods,
+})
+
+yg.ffi = {
+    api = ffi.cast("const ygif_api *", apiPtr),
+    vec3 = vec3,
+    trafo = function(t) return ffi.cast("ygif_Trafo *", trafoPointer(t)) end,
+    X = 0,
+    Y = 1,
+    Z = 2,
+}
+)lua";
+#endif
+    }
+
+    ygif_api const &getFfiApi()
+    {
+        return g_ffiApi;
+    }
+
+    char const *getFfiCdef()
+    {
+        return g_ffiCdef;
+    }
+
+    void registerFfi(lua_State *L)
+    {
+#if defined(YGIF_LUAJIT)
+        if (luaL_loadbuffer(L, ffiChunk, std::strlen(ffiChunk), "=ygif_ffi") != LUA_OK)
+        {
+            yg::log::error("registerFfi(): %v", lua_tostring(L, -1));
+            lua_pop(L, 1);
+            return;
+        }
+        lua_pushstring(L, g_ffiCdef);
+        lua_pushlightuserdata(L, const_cast<ygif_api *>(&g_ffiApi));
+        lua_pushcfunction(L, ffi_trafoPointer);
+        if (lua_pcall(L, 3, 0, 0) != LUA_OK)
+        {
+            yg::log::error("registerFfi(): %v", lua_tostring(L, -1));
+            lua_pop(L, 1);
+        }
+#else
+        (void)L;
+#endif
+    }
+}
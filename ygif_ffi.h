@@ -0,0 +1,73 @@
+#ifndef YGIF_FFI_H
+#define YGIF_FFI_H
+
+extern "C"
+{
+#include "lua.h"
+}
+
+// plain C entry points of hot-path bindings (trafo, vec3, input, time), for
+// calls from LuaJIT's FFI: no Lua stack, no LuaBridge type checks, and
+// compiled into JIT traces. they are reached through one table of function
+// pointers (ygif_api), not via exported symbols (ffi.C), which works the
+// same on desktop and android.
+// the C declarations below and the ffi.cdef() of the Lua side are both
+// generated from YGIF_FFI_TYPES and YGIF_FFI_FUNCTIONS.
+// arguments are not checked: trafo pointers come from yg.ffi.trafo(), and
+// the Trafo must be kept alive by the script while its pointer is used.
+
+#define YGIF_FFI_TYPES                                         \
+    typedef struct ygif_vec3 { float x, y, z; } ygif_vec3;     \
+    typedef struct ygif_Trafo ygif_Trafo; /* yg.math.Trafo */
+
+// X(return type, name, parameters). axis: 0, 1, 2 (X, Y, Z), source: input
+// source handle (yg.input.source()), unknown sources read as 0. rotations
+// around the zero vector (ax, ay, az) do nothing
+#define YGIF_FFI_FUNCTIONS(X)                                                                   \
+    X(void, trafo_translateLocal, (ygif_Trafo *t, float x, float y, float z))                   \
+    X(void, trafo_translateGlobal, (ygif_Trafo *t, float x, float y, float z))                  \
+    X(void, trafo_setTranslation, (ygif_Trafo *t, float x, float y, float z))                   \
+    X(void, trafo_setScaleLocal, (ygif_Trafo *t, float x, float y, float z))                    \
+    X(void, trafo_rotateLocal, (ygif_Trafo *t, float angle, float ax, float ay, float az))      \
+    X(void, trafo_rotateGlobal, (ygif_Trafo *t, float angle, float ax, float ay, float az))     \
+    X(void, trafo_rotateLocalAxis, (ygif_Trafo *t, float angle, int axis))                      \
+    X(void, trafo_rotateGlobalAxis, (ygif_Trafo *t, float angle, int axis))                     \
+    X(void, trafo_rotateEuler, (ygif_Trafo *t, float x, float y, float z))                      \
+    X(void, trafo_getEye, (ygif_Trafo *t, ygif_vec3 *out))                                      \
+    X(void, trafo_getScale, (ygif_Trafo *t, ygif_vec3 *out))                                    \
+    X(void, trafo_getAxisLocal, (ygif_Trafo *t, int axis, ygif_vec3 *out))                      \
+    X(void, trafo_getAxisGlobal, (ygif_Trafo *t, int axis, ygif_vec3 *out))                     \
+    X(void, trafo_transformPoint, (ygif_Trafo *t, ygif_vec3 const *in, ygif_vec3 *out))         \
+    X(void, vec3_rotate, (ygif_vec3 *v, float angle, float ax, float ay, float az))             \
+    X(float, input_get, (int source))                                                           \
+    X(int, input_geti, (int source))                                                            \
+    X(float, input_getDelta, (int source))                                                      \
+    X(double, time_getDelta, (void))                                                            \
+    X(double, time_getTime, (void))
+
+extern "C"
+{
+    YGIF_FFI_TYPES
+
+#define YGIF_FFI_FIELD(ret, name, params) ret(*name) params;
+    typedef struct ygif_api
+    {
+        YGIF_FFI_FUNCTIONS(YGIF_FFI_FIELD)
+    } ygif_api;
+#undef YGIF_FFI_FIELD
+}
+
+namespace mygame
+{
+    // the function table, filled with the host implementations
+    ygif_api const &getFfiApi();
+
+    // the ffi.cdef() declarations of ygif_vec3, ygif_Trafo and ygif_api
+    char const *getFfiCdef();
+
+    // LuaJIT builds (YGIF_LUAJIT): sets yg.ffi (see README), after
+    // registerLua(). does nothing with other Lua backends, yg.ffi stays nil
+    void registerFfi(lua_State *L);
+}
+
+#endif
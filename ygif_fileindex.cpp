@@ -0,0 +1,282 @@
+#include <algorithm>
+#include "yourgame/yourgame.h"
+#include "ygif_fileindex.h"
+
+#if defined(YOURGAME_PLATFORM_DESKTOP) && defined(__linux__)
+#define YGIF_FILEINDEX_INOTIFY
+#include <map>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+#if defined(YGIF_FILEINDEX_INOTIFY)
+    namespace
+    {
+        // one inotify instance for all indexes: instances are limited per
+        // user (fs.inotify.max_user_instances, 128 by default), watches much
+        // less so. indexes of the same directory share its watch
+        int g_inotifyFd = -1;
+        std::map<int, std::vector<FileIndex *>> g_watchers; // by watch descriptor
+    }
+#endif
+
+    double FileIndex::pollInterval = 1.0;
+
+    FileIndex::FileIndex(std::string const &prefix) : m_prefix(prefix)
+    {
+    }
+
+    FileIndex::~FileIndex()
+    {
+        unwatch();
+#if defined(YGIF_FILEINDEX_INOTIFY)
+        if (g_watchers.empty() && g_inotifyFd >= 0)
+        {
+            ::close(g_inotifyFd);
+            g_inotifyFd = -1;
+        }
+#endif
+    }
+
+    void FileIndex::update(double now)
+    {
+        // the project path may be set (or changed) at any time
+        std::string root;
+        if (m_prefix.compare(0, 3, "a//") == 0)
+        {
+            // assets are always there, even without a native path (android)
+            root = yg::file::getAssetFilePath(m_prefix.substr(3));
+            root = root.empty() ? m_prefix : root;
+        }
+        else if (yg::file::getProjectFilePath("") != "")
+        {
+            root = yg::file::getProjectFilePath(m_prefix.substr(3));
+        }
+        if (!m_scanned || root != m_root)
+        {
+            m_root = root;
+            m_lastPoll = now;
+            rescan(false);
+            return;
+        }
+
+        if (m_wd >= 0)
+        {
+            readEvents();
+            if (m_lost)
+            {
+                // events were dropped, or the directory itself went away:
+                // list it again and treat everything as changed
+                rescan(false);
+                for (auto const &f : m_files)
+                {
+                    addChanged(f);
+                }
+            }
+        }
+        else if (now - m_lastPoll >= pollInterval)
+        {
+            m_lastPoll = now;
+            rescan(true);
+        }
+    }
+
+    std::vector<std::string> const &FileIndex::files() const
+    {
+        return m_files;
+    }
+
+    uint64_t FileIndex::generation() const
+    {
+        return m_generation;
+    }
+
+    bool FileIndex::isWatching() const
+    {
+        return m_wd >= 0;
+    }
+
+    std::vector<std::string> FileIndex::takeChanged()
+    {
+        std::vector<std::string> changed;
+        changed.swap(m_changed);
+        return changed;
+    }
+
+    // (re)watches and lists the directory. reportAll: files not listed
+    // before are reported as changed (polling)
+    void FileIndex::rescan(bool reportAll)
+    {
+        // watch first: changes during the listing are not lost
+        unwatch();
+#if defined(YGIF_FILEINDEX_INOTIFY)
+        if (g_inotifyFd < 0)
+        {
+            g_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        }
+        if (g_inotifyFd >= 0 && !m_root.empty())
+        {
+            // same directory as another index: the same watch descriptor
+            m_wd = inotify_add_watch(g_inotifyFd, m_root.c_str(),
+                                     IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                         IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF);
+            if (m_wd >= 0)
+            {
+                g_watchers[m_wd].push_back(this);
+            }
+        }
+#endif
+        m_lost = false;
+
+        std::vector<std::string> files;
+        if (!m_root.empty())
+        {
+            files = yg::file::ls(m_prefix + "*");
+            std::sort(files.begin(), files.end());
+        }
+
+        if (reportAll)
+        {
+            for (auto const &f : files)
+            {
+                if (!std::binary_search(m_files.begin(), m_files.end(), f))
+                {
+                    addChanged(f);
+                }
+            }
+        }
+
+        if (!m_scanned || files != m_files)
+        {
+            m_files.swap(files);
+            ++m_generation;
+        }
+        m_scanned = true;
+    }
+
+    void FileIndex::unwatch()
+    {
+#if defined(YGIF_FILEINDEX_INOTIFY)
+        auto it = g_watchers.find(m_wd);
+        if (it != g_watchers.end())
+        {
+            std::vector<FileIndex *> &indexes = it->second;
+            indexes.erase(std::remove(indexes.begin(), indexes.end(), this), indexes.end());
+            if (indexes.empty())
+            {
+                inotify_rm_watch(g_inotifyFd, m_wd);
+                g_watchers.erase(it);
+            }
+        }
+#endif
+        m_wd = -1;
+    }
+
+    // reads the pending events of all watches, the first index to update()
+    // in a frame gets them for the others too
+    void FileIndex::readEvents()
+    {
+#if defined(YGIF_FILEINDEX_INOTIFY)
+        alignas(inotify_event) char buf[4096];
+        ssize_t len;
+        while (g_inotifyFd >= 0 && (len = ::read(g_inotifyFd, buf, sizeof(buf))) > 0)
+        {
+            for (char *p = buf; p < buf + len;)
+            {
+                inotify_event const *ev = reinterpret_cast<inotify_event const *>(p);
+                p += sizeof(inotify_event) + ev->len;
+
+                if (ev->mask & IN_Q_OVERFLOW)
+                {
+                    for (auto &w : g_watchers)
+                    {
+                        for (FileIndex *index : w.second)
+                        {
+                            index->m_lost = true;
+                        }
+                    }
+                    continue;
+                }
+                auto it = g_watchers.find(ev->wd);
+                if (it == g_watchers.end()) // removed watch of a previous root
+                {
+                    continue;
+                }
+                for (FileIndex *index : it->second)
+                {
+                    index->handleEvent(ev->mask, (ev->len > 0) ? ev->name : nullptr);
+                }
+            }
+        }
+#endif
+    }
+
+    void FileIndex::handleEvent(uint32_t mask, char const *name)
+    {
+#if defined(YGIF_FILEINDEX_INOTIFY)
+        if (mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+        {
+            m_lost = true;
+            return;
+        }
+        if (name == nullptr)
+        {
+            return;
+        }
+
+        std::string file = name;
+        if (mask & IN_ISDIR)
+        {
+            file += "/";
+        }
+        if (mask & (IN_CREATE | IN_MOVED_TO))
+        {
+            insertFile(file);
+        }
+        if (mask & (IN_DELETE | IN_MOVED_FROM))
+        {
+            eraseFile(file);
+        }
+        if ((mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && !(mask & IN_ISDIR))
+        {
+            addChanged(file);
+        }
+#else
+        (void)mask;
+        (void)name;
+#endif
+    }
+
+    void FileIndex::addChanged(std::string const &name)
+    {
+        std::string file = m_prefix + name;
+        if (std::find(m_changed.begin(), m_changed.end(), file) == m_changed.end())
+        {
+            m_changed.push_back(file);
+        }
+    }
+
+    void FileIndex::insertFile(std::string const &name)
+    {
+        auto it = std::lower_bound(m_files.begin(), m_files.end(), name);
+        if (it == m_files.end() || *it != name)
+        {
+            m_files.insert(it, name);
+            ++m_generation;
+        }
+    }
+
+    void FileIndex::eraseFile(std::string const &name)
+    {
+        auto it = std::lower_bound(m_files.begin(), m_files.end(), name);
+        if (it != m_files.end() && *it == name)
+        {
+            m_files.erase(it);
+            ++m_generation;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef YGIF_FILEINDEX_H
+#define YGIF_FILEINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mygame
+{
+    // listing of a yg::file directory ("a//", "p//" or a subdirectory like
+    // "p//dir/", as yg::file::ls() returns it: sorted, directories with
+    // trailing '/'), scanned once and
+    // kept up to date by update(). on Linux desktop, the directory is watched
+    // via inotify and the listing is updated from its events. all indexes
+    // share one inotify instance (limited per user), with a watch per
+    // directory. elsewhere (or if watching fails), the directory is listed
+    // again every pollInterval seconds and compared.
+    class FileIndex
+    {
+    public:
+        explicit FileIndex(std::string const &prefix);
+        FileIndex(FileIndex const &) = delete;
+        FileIndex &operator=(FileIndex const &) = delete;
+        ~FileIndex();
+
+        // main thread, once per frame. rescans if the directory changed
+        // (project path set, for instance)
+        void update(double now);
+
+        std::vector<std::string> const &files() const;
+
+        // incremented whenever files() changes
+        uint64_t generation() const;
+
+        // true if file content changes are reported by takeChanged(), false
+        // in polling mode (only new files are reported then)
+        bool isWatching() const;
+
+        // yg::file paths of the files created or written since the last call
+        std::vector<std::string> takeChanged();
+
+        static double pollInterval;
+
+    private:
+        void rescan(bool reportAll);
+        void unwatch();
+        static void readEvents(); // dispatches the events to the indexes
+        void handleEvent(uint32_t mask, char const *name);
+        void addChanged(std::string const &name);
+        void insertFile(std::string const &name);
+        void eraseFile(std::string const &name);
+
+        std::string m_prefix;
+        std::string m_root; // native path, "" if not available (no project path)
+        std::vector<std::string> m_files;
+        std::vector<std::string> m_changed;
+        uint64_t m_generation = 0;
+        bool m_scanned = false;
+        double m_lastPoll = 0.0;
+        int m_wd = -1;       // watch of m_root
+        bool m_lost = false; // events were dropped, or the directory went away
+    };
+}
+
+#endif
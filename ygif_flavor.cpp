@@ -0,0 +1,82 @@
+#include "ygif_flavor.h"
+
+using json = nlohmann::json;
+
+namespace mygame
+{
+    void FlavorStore::load(json const &flavor)
+    {
+        m_params.clear();
+        m_infos.clear();
+        m_slots.clear();
+
+        if (!flavor.is_object())
+        {
+            return;
+        }
+
+        for (auto &el : flavor.items())
+        {
+            auto &v = el.value();
+
+            if (!v.is_object() || !v.contains("type") || !v.contains("data") || !v["type"].is_string())
+            {
+                continue;
+            }
+
+            std::string type = v["type"].get<std::string>();
+            auto &data = v["data"];
+
+            Param p;
+            p.data[0] = p.data[1] = p.data[2] = 0.0f;
+            if (type.compare("number") == 0 && data.is_number())
+            {
+                p.type = Type::NUMBER;
+                p.data[0] = data.get<float>();
+            }
+            else if (type.compare("vec3") == 0 && data.is_array() && data.size() == 3)
+            {
+                p.type = Type::VEC3;
+                p.data[0] = data[0].get<float>();
+                p.data[1] = data[1].get<float>();
+                p.data[2] = data[2].get<float>();
+            }
+            else
+            {
+                continue;
+            }
+
+            ParamInfo info;
+            info.name = el.key();
+            info.unit = (v.contains("unit") && v["unit"].is_string()) ? v["unit"].get<std::string>() : "";
+            info.usage = (v.contains("usage") && v["usage"].is_string()) ? v["usage"].get<std::string>() : "";
+
+            m_slots[info.name] = static_cast<int>(m_params.size());
+            m_params.push_back(p);
+            m_infos.push_back(info);
+        }
+    }
+
+    void FlavorStore::save(json &flavor) const
+    {
+        for (std::size_t i = 0; i < m_params.size(); ++i)
+        {
+            auto &v = flavor[m_infos[i].name];
+            switch (m_params[i].type)
+            {
+            case Type::NUMBER:
+                v["data"] = m_params[i].data[0];
+                break;
+            case Type::VEC3:
+                v["data"] = {m_params[i].data[0], m_params[i].data[1], m_params[i].data[2]};
+                break;
+            }
+        }
+    }
+
+    int FlavorStore::handle(const char *name, std::size_t len) const
+    {
+        auto it = m_slots.find(std::string(name, len));
+        return (it == m_slots.end()) ? -1 : it->second;
+    }
+}
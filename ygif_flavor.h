@@ -0,0 +1,60 @@
+#ifndef YGIF_FLAVOR_H
+#define YGIF_FLAVOR_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+namespace mygame
+{
+    // flat, typed parameter store compiled from a flavor json document.
+    // parameters are addressed by slot (handle), the json document is only
+    // touched in load() and save().
+    class FlavorStore
+    {
+    public:
+        enum class Type
+        {
+            NUMBER,
+            VEC3
+        };
+
+        struct Param
+        {
+            Type type;
+            float data[3];
+        };
+
+        struct ParamInfo
+        {
+            std::string name;
+            std::string unit;
+            std::string usage;
+        };
+
+        // replaces all parameters with the ones from flavor.
+        // entries without valid "type" and "data" are skipped
+        void load(nlohmann::json const &flavor);
+
+        // writes the current parameter values back into flavor
+        void save(nlohmann::json &flavor) const;
+
+        // returns the slot of parameter name, or -1 if it does not exist
+        int handle(const char *name, std::size_t len) const;
+
+        std::size_t size() const { return m_params.size(); }
+        bool isValid(int handle) const { return handle >= 0 && static_cast<std::size_t>(handle) < m_params.size(); }
+        Param &param(int handle) { return m_params[handle]; }
+        Param const &param(int handle) const { return m_params[handle]; }
+        ParamInfo const &info(int handle) const { return m_infos[handle]; }
+
+    private:
+        std::vector<Param> m_params;
+        std::vector<ParamInfo> m_infos;
+        std::unordered_map<std::string, int> m_slots;
+    };
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "ygif_glstate.h"
+
+namespace mygame
+{
+    GlStateCache g_glState;
+
+    GlStateCache::Action GlStateCache::use(yourgame::gl::Shader *shader,
+                                           yourgame::gl::Lightsource const *light,
+                                           yourgame::math::Camera *camera)
+    {
+        ProgramState &p = m_programs[shader];
+        Action a = Action();
+
+        if (light != nullptr)
+        {
+            uint64_t version = lightVersion(light);
+            a.uploadLight = (p.light != light || p.lightVersion != version);
+            p.light = light;
+            p.lightVersion = version;
+            ++(a.uploadLight ? m_counters.uniformUploads : m_counters.uniformUploadsAvoided);
+        }
+
+        if (camera != nullptr)
+        {
+            glm::mat4 vMat = camera->vMat();
+            glm::mat4 pMat = camera->pMat();
+            a.uploadCamera = (p.camera != camera || p.vMat != vMat || p.pMat != pMat);
+            p.camera = camera;
+            p.vMat = vMat;
+            p.pMat = pMat;
+            ++(a.uploadCamera ? m_counters.uniformUploads : m_counters.uniformUploadsAvoided);
+        }
+
+        a.bind = (m_bound != shader);
+        m_bound = shader;
+        ++((a.bind || a.uploadLight || a.uploadCamera) ? m_counters.programBinds : m_counters.programBindsAvoided);
+        return a;
+    }
+
+    GLint GlStateCache::uniformLocation(yourgame::gl::Shader *shader, char const *name)
+    {
+        auto &locations = m_programs[shader].locations;
+        auto it = locations.find(name);
+        if (it == locations.end())
+        {
+            it = locations.insert({name, shader->getUniformLocation(name)}).first;
+        }
+        return it->second;
+    }
+
+    void GlStateCache::touchLight(yourgame::gl::Lightsource const *light)
+    {
+        m_lightVersions[light] = ++m_version;
+    }
+
+    void GlStateCache::forgetLight(yourgame::gl::Lightsource const *light)
+    {
+        m_lightVersions.erase(light);
+    }
+
+    void GlStateCache::forgetProgram(yourgame::gl::Shader *shader)
+    {
+        m_programs.erase(shader);
+        if (m_bound == shader)
+        {
+            m_bound = nullptr;
+        }
+    }
+
+    void GlStateCache::beginFrame()
+    {
+        m_lastFrame = m_counters;
+        m_counters = Counters();
+        m_bound = nullptr;
+    }
+
+    GlStateCache::Counters const &GlStateCache::lastFrame() const
+    {
+        return m_lastFrame;
+    }
+
+    uint64_t GlStateCache::lightVersion(yourgame::gl::Lightsource const *light) const
+    {
+        auto it = m_lightVersions.find(light);
+        return (it != m_lightVersions.end()) ? it->second : 0;
+    }
+}
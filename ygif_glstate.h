@@ -0,0 +1,83 @@
+#ifndef YGIF_GLSTATE_H
+#define YGIF_GLSTATE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "yourgame/yourgame.h"
+
+namespace mygame
+{
+    // tracks the GL program state set by host::useProgram(): the bound
+    // program, and per program the light and camera its uniforms were last
+    // uploaded for. redundant binds and uploads are skipped. uniform values
+    // are kept per program by GL, so switching back to a program with
+    // unchanged light and camera only binds it.
+    // light changes are reported by touchLight() (YgifLightsource setters),
+    // camera changes are detected by comparing the view and projection
+    // matrices.
+    class GlStateCache
+    {
+    public:
+        // what host::useProgram() has to do
+        struct Action
+        {
+            bool bind;          // bind the program
+            bool uploadLight;   // upload the light uniforms (binds)
+            bool uploadCamera;  // upload the camera uniforms (binds)
+        };
+
+        struct Counters
+        {
+            int programBinds;
+            int programBindsAvoided;
+            int uniformUploads; // light or camera uniform sets
+            int uniformUploadsAvoided;
+        };
+
+        Action use(yourgame::gl::Shader *shader,
+                   yourgame::gl::Lightsource const *light,
+                   yourgame::math::Camera *camera);
+
+        // cached uniform location of the program of shader
+        GLint uniformLocation(yourgame::gl::Shader *shader, char const *name);
+
+        // the light was created or changed
+        void touchLight(yourgame::gl::Lightsource const *light);
+        void forgetLight(yourgame::gl::Lightsource const *light);
+
+        // shader is deleted (its address may be reused)
+        void forgetProgram(yourgame::gl::Shader *shader);
+
+        // starts a frame: counters of the previous frame become available
+        // via lastFrame(), the bound program is unknown (other code, ImGui
+        // for instance, binds programs between frames)
+        void beginFrame();
+
+        Counters const &lastFrame() const;
+
+    private:
+        struct ProgramState
+        {
+            yourgame::gl::Lightsource const *light = nullptr;
+            uint64_t lightVersion = 0;
+            yourgame::math::Camera *camera = nullptr;
+            glm::mat4 vMat;
+            glm::mat4 pMat;
+            std::unordered_map<std::string, GLint> locations;
+        };
+
+        uint64_t lightVersion(yourgame::gl::Lightsource const *light) const;
+
+        std::unordered_map<yourgame::gl::Shader *, ProgramState> m_programs;
+        std::unordered_map<yourgame::gl::Lightsource const *, uint64_t> m_lightVersions;
+        uint64_t m_version = 0;
+        yourgame::gl::Shader *m_bound = nullptr;
+        Counters m_counters = Counters();
+        Counters m_lastFrame = Counters();
+    };
+
+    extern GlStateCache g_glState;
+}
+
+#endif
@@ -18,10 +18,26 @@ freely, subject to the following restrictions:
 3. This notice may not be removed or altered from any source distribution.
 */
 #include <array>
+#include <limits>
 #include "nlohmann/json.hpp"
 #include "yourgame/yourgame.h"
+#include "ygif_glue.h"
 #include "ygif_trafo.h"
 #include "ygif_camera.h"
+#include "ygif_light.h"
+#include "ygif_glstate.h"
+#include "ygif_input.h"
+#include "ygif_flavor.h"
+#include "ygif_vecmath.h"
+#include "ygif_draw.h"
+#include "ygif_culling.h"
+#include "ygif_trafopool.h"
+#include "ygif_picking.h"
+#include "ygif_host.h"
+#include "ygif_async.h"
+#include "ygif_runtime.h"
+#include "ygif_profiler.h"
+#include "ygif_luacompat.h"
 
 extern "C"
 {
@@ -41,8 +57,6 @@ namespace yg = yourgame; // convenience
 
 namespace mygame
 {
-    extern json g_flavor;
-
     // log ...
     void log_debug(std::string s)
     {
@@ -65,288 +79,333 @@ namespace mygame
     }
 
     // input ...
-    const std::map<std::string, yg::input::Source> str2input = {
-        {"KEY_UNKNOWN", yg::input::KEY_UNKNOWN},
-        {"KEY_SPACE", yg::input::KEY_SPACE},
-        {"KEY_APOSTROPHE", yg::input::KEY_APOSTROPHE},
-        {"KEY_COMMA", yg::input::KEY_COMMA},
-        {"KEY_MINUS", yg::input::KEY_MINUS},
-        {"KEY_PERIOD", yg::input::KEY_PERIOD},
-        {"KEY_SLASH", yg::input::KEY_SLASH},
-        {"KEY_0", yg::input::KEY_0},
-        {"KEY_1", yg::input::KEY_1},
-        {"KEY_2", yg::input::KEY_2},
-        {"KEY_3", yg::input::KEY_3},
-        {"KEY_4", yg::input::KEY_4},
-        {"KEY_5", yg::input::KEY_5},
-        {"KEY_6", yg::input::KEY_6},
-        {"KEY_7", yg::input::KEY_7},
-        {"KEY_8", yg::input::KEY_8},
-        {"KEY_9", yg::input::KEY_9},
-        {"KEY_SEMICOLON", yg::input::KEY_SEMICOLON},
-        {"KEY_EQUAL", yg::input::KEY_EQUAL},
-        {"KEY_A", yg::input::KEY_A},
-        {"KEY_B", yg::input::KEY_B},
-        {"KEY_C", yg::input::KEY_C},
-        {"KEY_D", yg::input::KEY_D},
-        {"KEY_E", yg::input::KEY_E},
-        {"KEY_F", yg::input::KEY_F},
-        {"KEY_G", yg::input::KEY_G},
-        {"KEY_H", yg::input::KEY_H},
-        {"KEY_I", yg::input::KEY_I},
-        {"KEY_J", yg::input::KEY_J},
-        {"KEY_K", yg::input::KEY_K},
-        {"KEY_L", yg::input::KEY_L},
-        {"KEY_M", yg::input::KEY_M},
-        {"KEY_N", yg::input::KEY_N},
-        {"KEY_O", yg::input::KEY_O},
-        {"KEY_P", yg::input::KEY_P},
-        {"KEY_Q", yg::input::KEY_Q},
-        {"KEY_R", yg::input::KEY_R},
-        {"KEY_S", yg::input::KEY_S},
-        {"KEY_T", yg::input::KEY_T},
-        {"KEY_U", yg::input::KEY_U},
-        {"KEY_V", yg::input::KEY_V},
-        {"KEY_W", yg::input::KEY_W},
-        {"KEY_X", yg::input::KEY_X},
-        {"KEY_Y", yg::input::KEY_Y},
-        {"KEY_Z", yg::input::KEY_Z},
-        {"KEY_LEFT_BRACKET", yg::input::KEY_LEFT_BRACKET},
-        {"KEY_BACKSLASH", yg::input::KEY_BACKSLASH},
-        {"KEY_RIGHT_BRACKET", yg::input::KEY_RIGHT_BRACKET},
-        {"KEY_GRAVE_ACCENT", yg::input::KEY_GRAVE_ACCENT},
-        {"KEY_WORLD_1", yg::input::KEY_WORLD_1},
-        {"KEY_WORLD_2", yg::input::KEY_WORLD_2},
-        {"KEY_ESCAPE", yg::input::KEY_ESCAPE},
-        {"KEY_ENTER", yg::input::KEY_ENTER},
-        {"KEY_TAB", yg::input::KEY_TAB},
-        {"KEY_BACKSPACE", yg::input::KEY_BACKSPACE},
-        {"KEY_INSERT", yg::input::KEY_INSERT},
-        {"KEY_DELETE", yg::input::KEY_DELETE},
-        {"KEY_RIGHT", yg::input::KEY_RIGHT},
-        {"KEY_LEFT", yg::input::KEY_LEFT},
-        {"KEY_DOWN", yg::input::KEY_DOWN},
-        {"KEY_UP", yg::input::KEY_UP},
-        {"KEY_PAGE_UP", yg::input::KEY_PAGE_UP},
-        {"KEY_PAGE_DOWN", yg::input::KEY_PAGE_DOWN},
-        {"KEY_HOME", yg::input::KEY_HOME},
-        {"KEY_END", yg::input::KEY_END},
-        {"KEY_CAPS_LOCK", yg::input::KEY_CAPS_LOCK},
-        {"KEY_SCROLL_LOCK", yg::input::KEY_SCROLL_LOCK},
-        {"KEY_NUM_LOCK", yg::input::KEY_NUM_LOCK},
-        {"KEY_PRINT_SCREEN", yg::input::KEY_PRINT_SCREEN},
-        {"KEY_PAUSE", yg::input::KEY_PAUSE},
-        {"KEY_F1", yg::input::KEY_F1},
-        {"KEY_F2", yg::input::KEY_F2},
-        {"KEY_F3", yg::input::KEY_F3},
-        {"KEY_F4", yg::input::KEY_F4},
-        {"KEY_F5", yg::input::KEY_F5},
-        {"KEY_F6", yg::input::KEY_F6},
-        {"KEY_F7", yg::input::KEY_F7},
-        {"KEY_F8", yg::input::KEY_F8},
-        {"KEY_F9", yg::input::KEY_F9},
-        {"KEY_F10", yg::input::KEY_F10},
-        {"KEY_F11", yg::input::KEY_F11},
-        {"KEY_F12", yg::input::KEY_F12},
-        {"KEY_F13", yg::input::KEY_F13},
-        {"KEY_F14", yg::input::KEY_F14},
-        {"KEY_F15", yg::input::KEY_F15},
-        {"KEY_F16", yg::input::KEY_F16},
-        {"KEY_F17", yg::input::KEY_F17},
-        {"KEY_F18", yg::input::KEY_F18},
-        {"KEY_F19", yg::input::KEY_F19},
-        {"KEY_F20", yg::input::KEY_F20},
-        {"KEY_F21", yg::input::KEY_F21},
-        {"KEY_F22", yg::input::KEY_F22},
-        {"KEY_F23", yg::input::KEY_F23},
-        {"KEY_F24", yg::input::KEY_F24},
-        {"KEY_F25", yg::input::KEY_F25},
-        {"KEY_KP_0", yg::input::KEY_KP_0},
-        {"KEY_KP_1", yg::input::KEY_KP_1},
-        {"KEY_KP_2", yg::input::KEY_KP_2},
-        {"KEY_KP_3", yg::input::KEY_KP_3},
-        {"KEY_KP_4", yg::input::KEY_KP_4},
-        {"KEY_KP_5", yg::input::KEY_KP_5},
-        {"KEY_KP_6", yg::input::KEY_KP_6},
-        {"KEY_KP_7", yg::input::KEY_KP_7},
-        {"KEY_KP_8", yg::input::KEY_KP_8},
-        {"KEY_KP_9", yg::input::KEY_KP_9},
-        {"KEY_KP_DECIMAL", yg::input::KEY_KP_DECIMAL},
-        {"KEY_KP_DIVIDE", yg::input::KEY_KP_DIVIDE},
-        {"KEY_KP_MULTIPLY", yg::input::KEY_KP_MULTIPLY},
-        {"KEY_KP_SUBTRACT", yg::input::KEY_KP_SUBTRACT},
-        {"KEY_KP_ADD", yg::input::KEY_KP_ADD},
-        {"KEY_KP_ENTER", yg::input::KEY_KP_ENTER},
-        {"KEY_KP_EQUAL", yg::input::KEY_KP_EQUAL},
-        {"KEY_LEFT_SHIFT", yg::input::KEY_LEFT_SHIFT},
-        {"KEY_LEFT_CONTROL", yg::input::KEY_LEFT_CONTROL},
-        {"KEY_LEFT_ALT", yg::input::KEY_LEFT_ALT},
-        {"KEY_LEFT_SUPER", yg::input::KEY_LEFT_SUPER},
-        {"KEY_RIGHT_SHIFT", yg::input::KEY_RIGHT_SHIFT},
-        {"KEY_RIGHT_CONTROL", yg::input::KEY_RIGHT_CONTROL},
-        {"KEY_RIGHT_ALT", yg::input::KEY_RIGHT_ALT},
-        {"KEY_RIGHT_SUPER", yg::input::KEY_RIGHT_SUPER},
-        {"KEY_MENU", yg::input::KEY_MENU},
-        {"MOUSE_X", yg::input::MOUSE_X},
-        {"MOUSE_Y", yg::input::MOUSE_Y},
-        {"MOUSE_BUTTON_1", yg::input::MOUSE_BUTTON_1},
-        {"MOUSE_BUTTON_2", yg::input::MOUSE_BUTTON_2},
-        {"MOUSE_BUTTON_3", yg::input::MOUSE_BUTTON_3},
-        {"MOUSE_BUTTON_4", yg::input::MOUSE_BUTTON_4},
-        {"MOUSE_BUTTON_5", yg::input::MOUSE_BUTTON_5},
-        {"MOUSE_BUTTON_6", yg::input::MOUSE_BUTTON_6},
-        {"MOUSE_BUTTON_7", yg::input::MOUSE_BUTTON_7},
-        {"MOUSE_BUTTON_8", yg::input::MOUSE_BUTTON_8},
-        {"SCROLL_OFFSET_X", yg::input::SCROLL_OFFSET_X},
-        {"SCROLL_OFFSET_Y", yg::input::SCROLL_OFFSET_Y},
-        {"TOUCH_0_DOWN", yg::input::TOUCH_0_DOWN},
-        {"TOUCH_0_X", yg::input::TOUCH_0_X},
-        {"TOUCH_0_Y", yg::input::TOUCH_0_Y},
-        {"TOUCH_1_DOWN", yg::input::TOUCH_1_DOWN},
-        {"TOUCH_1_X", yg::input::TOUCH_1_X},
-        {"TOUCH_1_Y", yg::input::TOUCH_1_Y},
-        {"TOUCH_2_DOWN", yg::input::TOUCH_2_DOWN},
-        {"TOUCH_2_X", yg::input::TOUCH_2_X},
-        {"TOUCH_2_Y", yg::input::TOUCH_2_Y},
-        {"TOUCH_3_DOWN", yg::input::TOUCH_3_DOWN},
-        {"TOUCH_3_X", yg::input::TOUCH_3_X},
-        {"TOUCH_3_Y", yg::input::TOUCH_3_Y},
-        {"TOUCH_4_DOWN", yg::input::TOUCH_4_DOWN},
-        {"TOUCH_4_X", yg::input::TOUCH_4_X},
-        {"TOUCH_4_Y", yg::input::TOUCH_4_Y},
-        {"TOUCH_5_DOWN", yg::input::TOUCH_5_DOWN},
-        {"TOUCH_5_X", yg::input::TOUCH_5_X},
-        {"TOUCH_5_Y", yg::input::TOUCH_5_Y},
-        {"TOUCH_6_DOWN", yg::input::TOUCH_6_DOWN},
-        {"TOUCH_6_X", yg::input::TOUCH_6_X},
-        {"TOUCH_6_Y", yg::input::TOUCH_6_Y},
-        {"TOUCH_7_DOWN", yg::input::TOUCH_7_DOWN},
-        {"TOUCH_7_X", yg::input::TOUCH_7_X},
-        {"TOUCH_7_Y", yg::input::TOUCH_7_Y},
-        {"TOUCH_8_DOWN", yg::input::TOUCH_8_DOWN},
-        {"TOUCH_8_X", yg::input::TOUCH_8_X},
-        {"TOUCH_8_Y", yg::input::TOUCH_8_Y},
-        {"TOUCH_9_DOWN", yg::input::TOUCH_9_DOWN},
-        {"TOUCH_9_X", yg::input::TOUCH_9_X},
-        {"TOUCH_9_Y", yg::input::TOUCH_9_Y},
-        {"GAMEPAD_0_CONNECTED", yg::input::GAMEPAD_0_CONNECTED},
-        {"GAMEPAD_0_BUTTON_A", yg::input::GAMEPAD_0_BUTTON_A},
-        {"GAMEPAD_0_BUTTON_B", yg::input::GAMEPAD_0_BUTTON_B},
-        {"GAMEPAD_0_BUTTON_X", yg::input::GAMEPAD_0_BUTTON_X},
-        {"GAMEPAD_0_BUTTON_Y", yg::input::GAMEPAD_0_BUTTON_Y},
-        {"GAMEPAD_0_BUTTON_LEFT_BUMPER", yg::input::GAMEPAD_0_BUTTON_LEFT_BUMPER},
-        {"GAMEPAD_0_BUTTON_RIGHT_BUMPER", yg::input::GAMEPAD_0_BUTTON_RIGHT_BUMPER},
-        {"GAMEPAD_0_BUTTON_BACK", yg::input::GAMEPAD_0_BUTTON_BACK},
-        {"GAMEPAD_0_BUTTON_START", yg::input::GAMEPAD_0_BUTTON_START},
-        {"GAMEPAD_0_BUTTON_GUIDE", yg::input::GAMEPAD_0_BUTTON_GUIDE},
-        {"GAMEPAD_0_BUTTON_LEFT_THUMB", yg::input::GAMEPAD_0_BUTTON_LEFT_THUMB},
-        {"GAMEPAD_0_BUTTON_RIGHT_THUMB", yg::input::GAMEPAD_0_BUTTON_RIGHT_THUMB},
-        {"GAMEPAD_0_BUTTON_DPAD_UP", yg::input::GAMEPAD_0_BUTTON_DPAD_UP},
-        {"GAMEPAD_0_BUTTON_DPAD_RIGHT", yg::input::GAMEPAD_0_BUTTON_DPAD_RIGHT},
-        {"GAMEPAD_0_BUTTON_DPAD_DOWN", yg::input::GAMEPAD_0_BUTTON_DPAD_DOWN},
-        {"GAMEPAD_0_BUTTON_DPAD_LEFT", yg::input::GAMEPAD_0_BUTTON_DPAD_LEFT},
-        {"GAMEPAD_0_AXIS_LEFT_X", yg::input::GAMEPAD_0_AXIS_LEFT_X},
-        {"GAMEPAD_0_AXIS_LEFT_Y", yg::input::GAMEPAD_0_AXIS_LEFT_Y},
-        {"GAMEPAD_0_AXIS_RIGHT_X", yg::input::GAMEPAD_0_AXIS_RIGHT_X},
-        {"GAMEPAD_0_AXIS_RIGHT_Y", yg::input::GAMEPAD_0_AXIS_RIGHT_Y},
-        {"GAMEPAD_0_AXIS_LEFT_TRIGGER", yg::input::GAMEPAD_0_AXIS_LEFT_TRIGGER},
-        {"GAMEPAD_0_AXIS_RIGHT_TRIGGER", yg::input::GAMEPAD_0_AXIS_RIGHT_TRIGGER},
-        {"GAMEPAD_1_CONNECTED", yg::input::GAMEPAD_1_CONNECTED},
-        {"GAMEPAD_1_BUTTON_A", yg::input::GAMEPAD_1_BUTTON_A},
-        {"GAMEPAD_1_BUTTON_B", yg::input::GAMEPAD_1_BUTTON_B},
-        {"GAMEPAD_1_BUTTON_X", yg::input::GAMEPAD_1_BUTTON_X},
-        {"GAMEPAD_1_BUTTON_Y", yg::input::GAMEPAD_1_BUTTON_Y},
-        {"GAMEPAD_1_BUTTON_LEFT_BUMPER", yg::input::GAMEPAD_1_BUTTON_LEFT_BUMPER},
-        {"GAMEPAD_1_BUTTON_RIGHT_BUMPER", yg::input::GAMEPAD_1_BUTTON_RIGHT_BUMPER},
-        {"GAMEPAD_1_BUTTON_BACK", yg::input::GAMEPAD_1_BUTTON_BACK},
-        {"GAMEPAD_1_BUTTON_START", yg::input::GAMEPAD_1_BUTTON_START},
-        {"GAMEPAD_1_BUTTON_GUIDE", yg::input::GAMEPAD_1_BUTTON_GUIDE},
-        {"GAMEPAD_1_BUTTON_LEFT_THUMB", yg::input::GAMEPAD_1_BUTTON_LEFT_THUMB},
-        {"GAMEPAD_1_BUTTON_RIGHT_THUMB", yg::input::GAMEPAD_1_BUTTON_RIGHT_THUMB},
-        {"GAMEPAD_1_BUTTON_DPAD_UP", yg::input::GAMEPAD_1_BUTTON_DPAD_UP},
-        {"GAMEPAD_1_BUTTON_DPAD_RIGHT", yg::input::GAMEPAD_1_BUTTON_DPAD_RIGHT},
-        {"GAMEPAD_1_BUTTON_DPAD_DOWN", yg::input::GAMEPAD_1_BUTTON_DPAD_DOWN},
-        {"GAMEPAD_1_BUTTON_DPAD_LEFT", yg::input::GAMEPAD_1_BUTTON_DPAD_LEFT},
-        {"GAMEPAD_1_AXIS_LEFT_X", yg::input::GAMEPAD_1_AXIS_LEFT_X},
-        {"GAMEPAD_1_AXIS_LEFT_Y", yg::input::GAMEPAD_1_AXIS_LEFT_Y},
-        {"GAMEPAD_1_AXIS_RIGHT_X", yg::input::GAMEPAD_1_AXIS_RIGHT_X},
-        {"GAMEPAD_1_AXIS_RIGHT_Y", yg::input::GAMEPAD_1_AXIS_RIGHT_Y},
-        {"GAMEPAD_1_AXIS_LEFT_TRIGGER", yg::input::GAMEPAD_1_AXIS_LEFT_TRIGGER},
-        {"GAMEPAD_1_AXIS_RIGHT_TRIGGER", yg::input::GAMEPAD_1_AXIS_RIGHT_TRIGGER},
-        {"GAMEPAD_2_CONNECTED", yg::input::GAMEPAD_2_CONNECTED},
-        {"GAMEPAD_2_BUTTON_A", yg::input::GAMEPAD_2_BUTTON_A},
-        {"GAMEPAD_2_BUTTON_B", yg::input::GAMEPAD_2_BUTTON_B},
-        {"GAMEPAD_2_BUTTON_X", yg::input::GAMEPAD_2_BUTTON_X},
-        {"GAMEPAD_2_BUTTON_Y", yg::input::GAMEPAD_2_BUTTON_Y},
-        {"GAMEPAD_2_BUTTON_LEFT_BUMPER", yg::input::GAMEPAD_2_BUTTON_LEFT_BUMPER},
-        {"GAMEPAD_2_BUTTON_RIGHT_BUMPER", yg::input::GAMEPAD_2_BUTTON_RIGHT_BUMPER},
-        {"GAMEPAD_2_BUTTON_BACK", yg::input::GAMEPAD_2_BUTTON_BACK},
-        {"GAMEPAD_2_BUTTON_START", yg::input::GAMEPAD_2_BUTTON_START},
-        {"GAMEPAD_2_BUTTON_GUIDE", yg::input::GAMEPAD_2_BUTTON_GUIDE},
-        {"GAMEPAD_2_BUTTON_LEFT_THUMB", yg::input::GAMEPAD_2_BUTTON_LEFT_THUMB},
-        {"GAMEPAD_2_BUTTON_RIGHT_THUMB", yg::input::GAMEPAD_2_BUTTON_RIGHT_THUMB},
-        {"GAMEPAD_2_BUTTON_DPAD_UP", yg::input::GAMEPAD_2_BUTTON_DPAD_UP},
-        {"GAMEPAD_2_BUTTON_DPAD_RIGHT", yg::input::GAMEPAD_2_BUTTON_DPAD_RIGHT},
-        {"GAMEPAD_2_BUTTON_DPAD_DOWN", yg::input::GAMEPAD_2_BUTTON_DPAD_DOWN},
-        {"GAMEPAD_2_BUTTON_DPAD_LEFT", yg::input::GAMEPAD_2_BUTTON_DPAD_LEFT},
-        {"GAMEPAD_2_AXIS_LEFT_X", yg::input::GAMEPAD_2_AXIS_LEFT_X},
-        {"GAMEPAD_2_AXIS_LEFT_Y", yg::input::GAMEPAD_2_AXIS_LEFT_Y},
-        {"GAMEPAD_2_AXIS_RIGHT_X", yg::input::GAMEPAD_2_AXIS_RIGHT_X},
-        {"GAMEPAD_2_AXIS_RIGHT_Y", yg::input::GAMEPAD_2_AXIS_RIGHT_Y},
-        {"GAMEPAD_2_AXIS_LEFT_TRIGGER", yg::input::GAMEPAD_2_AXIS_LEFT_TRIGGER},
-        {"GAMEPAD_2_AXIS_RIGHT_TRIGGER", yg::input::GAMEPAD_2_AXIS_RIGHT_TRIGGER},
-        {"GAMEPAD_3_CONNECTED", yg::input::GAMEPAD_3_CONNECTED},
-        {"GAMEPAD_3_BUTTON_A", yg::input::GAMEPAD_3_BUTTON_A},
-        {"GAMEPAD_3_BUTTON_B", yg::input::GAMEPAD_3_BUTTON_B},
-        {"GAMEPAD_3_BUTTON_X", yg::input::GAMEPAD_3_BUTTON_X},
-        {"GAMEPAD_3_BUTTON_Y", yg::input::GAMEPAD_3_BUTTON_Y},
-        {"GAMEPAD_3_BUTTON_LEFT_BUMPER", yg::input::GAMEPAD_3_BUTTON_LEFT_BUMPER},
-        {"GAMEPAD_3_BUTTON_RIGHT_BUMPER", yg::input::GAMEPAD_3_BUTTON_RIGHT_BUMPER},
-        {"GAMEPAD_3_BUTTON_BACK", yg::input::GAMEPAD_3_BUTTON_BACK},
-        {"GAMEPAD_3_BUTTON_START", yg::input::GAMEPAD_3_BUTTON_START},
-        {"GAMEPAD_3_BUTTON_GUIDE", yg::input::GAMEPAD_3_BUTTON_GUIDE},
-        {"GAMEPAD_3_BUTTON_LEFT_THUMB", yg::input::GAMEPAD_3_BUTTON_LEFT_THUMB},
-        {"GAMEPAD_3_BUTTON_RIGHT_THUMB", yg::input::GAMEPAD_3_BUTTON_RIGHT_THUMB},
-        {"GAMEPAD_3_BUTTON_DPAD_UP", yg::input::GAMEPAD_3_BUTTON_DPAD_UP},
-        {"GAMEPAD_3_BUTTON_DPAD_RIGHT", yg::input::GAMEPAD_3_BUTTON_DPAD_RIGHT},
-        {"GAMEPAD_3_BUTTON_DPAD_DOWN", yg::input::GAMEPAD_3_BUTTON_DPAD_DOWN},
-        {"GAMEPAD_3_BUTTON_DPAD_LEFT", yg::input::GAMEPAD_3_BUTTON_DPAD_LEFT},
-        {"GAMEPAD_3_AXIS_LEFT_X", yg::input::GAMEPAD_3_AXIS_LEFT_X},
-        {"GAMEPAD_3_AXIS_LEFT_Y", yg::input::GAMEPAD_3_AXIS_LEFT_Y},
-        {"GAMEPAD_3_AXIS_RIGHT_X", yg::input::GAMEPAD_3_AXIS_RIGHT_X},
-        {"GAMEPAD_3_AXIS_RIGHT_Y", yg::input::GAMEPAD_3_AXIS_RIGHT_Y},
-        {"GAMEPAD_3_AXIS_LEFT_TRIGGER", yg::input::GAMEPAD_3_AXIS_LEFT_TRIGGER},
-        {"GAMEPAD_3_AXIS_RIGHT_TRIGGER", yg::input::GAMEPAD_3_AXIS_RIGHT_TRIGGER},
-        {"WINDOW_WIDTH", yg::input::WINDOW_WIDTH},
-        {"WINDOW_HEIGHT", yg::input::WINDOW_HEIGHT},
-        {"WINDOW_ASPECT_RATIO", yg::input::WINDOW_ASPECT_RATIO},
-        {"WINDOW_FULLSCREEN", yg::input::WINDOW_FULLSCREEN},
-        {"VSYNC_ON", yg::input::VSYNC_ON},
-        {"MOUSE_CATCHED", yg::input::MOUSE_CATCHED}};
-
-    float input_get(std::string source)
+    // the input functions are plain lua_CFunctions: they accept a source handle
+    // (integer, from yg.input.source() or yg.input.<NAME>) or a source name (string)
+    // and read it from the stack directly, without constructing a std::string.
+    int input_source(lua_State *L)
+    {
+        yg::input::Source src;
+        if (toInputSource(L, 1, src))
+        {
+            lua_pushinteger(L, static_cast<lua_Integer>(src));
+        }
+        else
+        {
+            lua_pushnil(L);
+        }
+        return 1;
+    }
+
+    int input_get(lua_State *L)
+    {
+        yg::input::Source src;
+        lua_pushnumber(L, toInputSource(L, 1, src) ? host::inputGet(src) : 0.0f);
+        return 1;
+    }
+
+    int input_geti(lua_State *L)
+    {
+        yg::input::Source src;
+        lua_pushinteger(L, toInputSource(L, 1, src) ? host::inputGeti(src) : 0);
+        return 1;
+    }
+
+    int input_getDelta(lua_State *L)
+    {
+        yg::input::Source src;
+        lua_pushnumber(L, toInputSource(L, 1, src) ? host::inputGetDelta(src) : 0.0f);
+        return 1;
+    }
+
+    // yg.input.snapshot(sources [, snap]) reads all sources in one call.
+    // sources is an array of source handles or names. snap (optional) is the
+    // table returned by a previous call, which is refilled instead of allocating
+    // a new one. returns snap, with snap.get, snap.geti and snap.getDelta mapping
+    // each entry of sources to its value (0 for unknown sources).
+    int input_snapshot(lua_State *L)
+    {
+        if (!lua_istable(L, 1))
+        {
+            return luaL_error(L, "yg.input.snapshot(): #1 argument must be table");
+        }
+        lua_Integer numSources = static_cast<lua_Integer>(lua_rawlen(L, 1));
+
+        // snap table (index 2), reused if passed in
+        lua_settop(L, 2);
+        if (!lua_istable(L, 2))
+        {
+            lua_pop(L, 1);
+            lua_createtable(L, 0, 3);
+        }
+
+        // snap.get, snap.geti, snap.getDelta (indices 3, 4, 5)
+        static const char *fieldNames[] = {"get", "geti", "getDelta"};
+        for (int f = 0; f < 3; ++f)
+        {
+            lua_getfield(L, 2, fieldNames[f]);
+            if (!lua_istable(L, -1))
+            {
+                lua_pop(L, 1);
+                lua_createtable(L, 0, static_cast<int>(numSources));
+                lua_pushvalue(L, -1);
+                lua_setfield(L, 2, fieldNames[f]);
+            }
+        }
+
+        for (lua_Integer i = 1; i <= numSources; ++i)
+        {
+            lua_rawgeti(L, 1, i); // key (index 6)
+            if (lua_isnil(L, -1))
+            {
+                lua_pop(L, 1);
+                continue;
+            }
+            yg::input::Source src;
+            bool valid = toInputSource(L, 6, src);
+
+            lua_pushvalue(L, 6);
+            lua_pushnumber(L, valid ? host::inputGet(src) : 0.0f);
+            lua_rawset(L, 3);
+
+            lua_pushvalue(L, 6);
+            lua_pushinteger(L, valid ? host::inputGeti(src) : 0);
+            lua_rawset(L, 4);
+
+            lua_pushvalue(L, 6);
+            lua_pushnumber(L, valid ? host::inputGetDelta(src) : 0.0f);
+            lua_rawset(L, 5);
+
+            lua_pop(L, 1);
+        }
+
+        lua_settop(L, 2);
+        return 1;
+    }
+
+    // sets yg.input.<NAME> = <handle> for all known input sources
+    void registerInputConstants(lua_State *L)
+    {
+        std::size_t numNames = 0;
+        const InputSourceName *names = getInputSourceNames(numNames);
+        setYgFields(L, "input", numNames, [names](lua_State *L, std::size_t i) {
+            lua_pushstring(L, names[i].name);
+            lua_pushinteger(L, static_cast<lua_Integer>(names[i].source));
+        });
+    }
+
+    // gl ...
+    namespace
+    {
+        char resourceHandlesKey;
+        char releasedMetatableKey;
+
+        // pushes registry[key], created by create() on first use
+        void getRegistryTable(lua_State *L, void *key, void (*create)(lua_State *L))
+        {
+            lua_pushlightuserdata(L, key);
+            lua_rawget(L, LUA_REGISTRYINDEX);
+            if (lua_isnil(L, -1))
+            {
+                lua_pop(L, 1);
+                create(L);
+                lua_pushlightuserdata(L, key);
+                lua_pushvalue(L, -2);
+                lua_rawset(L, LUA_REGISTRYINDEX);
+            }
+        }
+
+        // resource (light userdata) -> its userdata, weak values
+        void createResourceHandles(lua_State *L)
+        {
+            lua_newtable(L);
+            lua_createtable(L, 0, 1);
+            lua_pushstring(L, "v");
+            lua_setfield(L, -2, "__mode");
+            lua_setmetatable(L, -2);
+        }
+
+        int releasedToString(lua_State *L)
+        {
+            lua_pushstring(L, "released resource");
+            return 1;
+        }
+
+        // metatable of released resources: not a LuaBridge class, so passing
+        // them to a binding raises "Geometry expected" (or "Shader expected")
+        void createReleasedMetatable(lua_State *L)
+        {
+            lua_createtable(L, 0, 1);
+            lua_pushcfunction(L, releasedToString);
+            lua_setfield(L, -2, "__tostring");
+        }
+
+        template <class T>
+        int releaseResource(lua_State *L)
+        {
+            T *resource = luabridge::Stack<T *>::get(L, 1);
+            if (!g_resources.release(resource))
+            {
+                return 0;
+            }
+
+            // freed: invalidate the userdata of resource, and arg 1
+            getRegistryTable(L, &resourceHandlesKey, createResourceHandles);
+            lua_pushlightuserdata(L, resource);
+            lua_rawget(L, -2);
+            getRegistryTable(L, &releasedMetatableKey, createReleasedMetatable);
+            if (lua_isuserdata(L, -2))
+            {
+                lua_pushvalue(L, -1);
+                lua_setmetatable(L, -3);
+            }
+            lua_setmetatable(L, 1);
+            lua_pop(L, 1);
+            lua_pushlightuserdata(L, resource);
+            lua_pushnil(L);
+            lua_rawset(L, -3);
+            lua_pop(L, 1);
+            return 0;
+        }
+
+        template <class T>
+        void pushResource(lua_State *L, T *resource)
+        {
+            if (resource == nullptr)
+            {
+                lua_pushnil(L);
+                return;
+            }
+
+            getRegistryTable(L, &resourceHandlesKey, createResourceHandles);
+            lua_pushlightuserdata(L, resource);
+            lua_rawget(L, -2);
+            if (lua_isnil(L, -1))
+            {
+                lua_pop(L, 1);
+                luabridge::Stack<T *>::push(L, resource);
+                lua_pushlightuserdata(L, resource);
+                lua_pushvalue(L, -2);
+                lua_rawset(L, -4);
+            }
+            lua_remove(L, -2);
+        }
+    }
+
+    void pushGeometry(lua_State *L, yg::gl::Geometry *geo)
+    {
+        pushResource(L, geo);
+    }
+
+    void pushShader(lua_State *L, yg::gl::Shader *shader)
     {
-        auto i = str2input.find(source);
-        return (i == str2input.end()) ? 0.0f : yg::input::get(i->second);
+        pushResource(L, shader);
     }
 
-    int input_geti(std::string source)
+    int loadGeometry(lua_State *L)
     {
-        auto i = str2input.find(source);
-        return (i == str2input.end()) ? 0.0f : yg::input::geti(i->second);
+        pushGeometry(L, g_resources.acquireGeometry(luaL_checkstring(L, 1)));
+        return 1;
     }
 
-    float input_getDelta(std::string source)
+    int loadVertFragShader(lua_State *L)
     {
-        auto i = str2input.find(source);
-        return (i == str2input.end()) ? 0.0f : yg::input::getDelta(i->second);
+        pushShader(L, g_resources.acquireVertFragShader(luaL_checkstring(L, 1), luaL_checkstring(L, 2)));
+        return 1;
+    }
+
+    // audio ...
+    bool audio_storeFile(std::string filename)
+    {
+        return g_resources.acquireAudioFile(filename);
+    }
+
+    // task ...
+    int task_spawn(lua_State *L)
+    {
+        luaL_checktype(L, 1, LUA_TFUNCTION);
+        return g_tasks.spawn(L);
+    }
+
+    int task_cancel(lua_State *L)
+    {
+        luaL_checktype(L, 1, LUA_TTHREAD);
+        return g_tasks.cancel(L, lua_tothread(L, 1));
+    }
+
+    int task_wait(lua_State *L)
+    {
+        return g_tasks.wait(L, luaL_optnumber(L, 1, 0.0));
+    }
+
+    int task_waitFrames(lua_State *L)
+    {
+        return g_tasks.waitFrames(L, static_cast<int>(luaL_optinteger(L, 1, 1)));
+    }
+
+    int task_waitUntil(lua_State *L)
+    {
+        LoadHandle *handle = luabridge::Stack<LoadHandle *>::get(L, 1);
+        luaL_argcheck(L, handle != nullptr, 1, "LoadHandle expected");
+        return g_tasks.waitUntil(L, *handle);
+    }
+
+    // resources ...
+    int resources_stats(lua_State *L)
+    {
+        ResourceCache::Stats stats = g_resources.stats();
+        lua_createtable(L, 0, 5);
+        lua_pushinteger(L, stats.geometries);
+        lua_setfield(L, -2, "geometries");
+        lua_pushinteger(L, stats.shaders);
+        lua_setfield(L, -2, "shaders");
+        lua_pushinteger(L, stats.audioFiles);
+        lua_setfield(L, -2, "audioFiles");
+        lua_pushinteger(L, stats.refs);
+        lua_setfield(L, -2, "refs");
+        lua_pushinteger(L, static_cast<lua_Integer>(stats.bytes));
+        lua_setfield(L, -2, "bytes");
+        return 1;
+    }
+
+    // memory ...
+    // Lua heap (g_luaAlloc): live, peak and limit [bytes], allocations of the last tick
+    int memory_stats(lua_State *L)
+    {
+        LuaAllocator::Stats const &stats = g_luaAlloc.stats();
+        LuaAllocator::Stats const &tick = g_luaAlloc.lastTick();
+        lua_createtable(L, 0, 7);
+        lua_pushinteger(L, static_cast<lua_Integer>(stats.liveBytes));
+        lua_setfield(L, -2, "liveBytes");
+        lua_pushinteger(L, static_cast<lua_Integer>(stats.peakBytes));
+        lua_setfield(L, -2, "peakBytes");
+        lua_pushinteger(L, static_cast<lua_Integer>(g_luaAlloc.limit()));
+        lua_setfield(L, -2, "limit");
+        lua_pushinteger(L, static_cast<lua_Integer>(tick.allocs));
+        lua_setfield(L, -2, "allocs");
+        lua_pushinteger(L, static_cast<lua_Integer>(tick.frees));
+        lua_setfield(L, -2, "frees");
+        lua_pushinteger(L, static_cast<lua_Integer>(tick.systemAllocs));
+        lua_setfield(L, -2, "systemAllocs");
+        lua_pushinteger(L, static_cast<lua_Integer>(stats.failedAllocs));
+        lua_setfield(L, -2, "failedAllocs");
+        return 1;
     }
 
     // gl ...
-    yg::gl::Shader *loadVertFragShader(std::string vertFilename, std::string fragFilename)
+    // program binds and light/camera uniform uploads of the last frame
+    int gl_stateStats(lua_State *L)
     {
-        return yg::gl::loadShader({{GL_VERTEX_SHADER, vertFilename},
-                                   {GL_FRAGMENT_SHADER, fragFilename}});
+        GlStateCache::Counters const &c = g_glState.lastFrame();
+        lua_createtable(L, 0, 4);
+        lua_pushinteger(L, c.programBinds);
+        lua_setfield(L, -2, "programBinds");
+        lua_pushinteger(L, c.programBindsAvoided);
+        lua_setfield(L, -2, "programBindsAvoided");
+        lua_pushinteger(L, c.uniformUploads);
+        lua_setfield(L, -2, "uniformUploads");
+        lua_pushinteger(L, c.uniformUploadsAvoided);
+        lua_setfield(L, -2, "uniformUploadsAvoided");
+        return 1;
     }
 
     void gl_draw(yg::gl::Geometry *geo,
@@ -355,57 +414,121 @@ namespace mygame
                  yg::math::Camera *camera,
                  yg::math::Trafo *trafo)
     {
-        shader->useProgram(light, camera);
+        ProfileScope scope(Profiler::SECTION_DRAW);
         yg::gl::DrawConfig cfg;
         cfg.camera = camera;
         if (trafo != nullptr)
         {
             cfg.modelMat = trafo->mat();
         }
+
+        // frustum culling, before binding any state
+        Bounds const *bounds = getGeometryBounds(geo);
+        if (g_frustumCulling && camera != nullptr && bounds != nullptr &&
+            !Frustum(camera).intersects(*bounds, cfg.modelMat))
+        {
+            g_profiler.countDraws(0, 1);
+            return;
+        }
+        g_profiler.countDraws(1, 0);
+
+        host::useProgram(shader, light, camera);
         cfg.shader = shader;
-        yg::gl::drawGeo(geo, cfg);
+        host::drawGeo(geo, cfg);
     }
 
     // flavor ...
-    std::array<float, 3> flavor_getVec3(std::string name)
+    // reads a flavor parameter from the Lua stack at idx: a slot handle
+    // (integer, from yg.flavor.handle()) or a parameter name (string).
+    // returns -1 if the parameter does not exist
+    int toFlavorHandle(lua_State *L, int idx)
+    {
+        switch (lua_type(L, idx))
+        {
+        case LUA_TNUMBER:
+        {
+            // range-checked before narrowing, fractions are no handles
+            lua_Integer h = 0;
+            if (!luaToIntegral(L, idx, h) || h < 0 || h > std::numeric_limits<int>::max())
+            {
+                return -1;
+            }
+            return g_flavorParams.isValid(static_cast<int>(h)) ? static_cast<int>(h) : -1;
+        }
+        case LUA_TSTRING:
+        {
+            std::size_t len = 0;
+            const char *name = lua_tolstring(L, idx, &len);
+            return g_flavorParams.handle(name, len);
+        }
+        default:
+            return -1;
+        }
+    }
+
+    int flavor_handle(lua_State *L)
+    {
+        int h = toFlavorHandle(L, 1);
+        if (h < 0)
+        {
+            lua_pushnil(L);
+        }
+        else
+        {
+            lua_pushinteger(L, h);
+        }
+        return 1;
+    }
+
+    int flavor_getVec3(lua_State *L)
     {
         std::array<float, 3> data{0.0f, 0.0f, 0.0f};
-        if (g_flavor.contains(name) &&
-            g_flavor[name]["type"].get<std::string>().compare("vec3") == 0)
+        int h = toFlavorHandle(L, 1);
+        if (h >= 0 && g_flavorParams.param(h).type == FlavorStore::Type::VEC3)
+        {
+            data[0] = g_flavorParams.param(h).data[0];
+            data[1] = g_flavorParams.param(h).data[1];
+            data[2] = g_flavorParams.param(h).data[2];
+        }
+        luabridge::Stack<std::array<float, 3>>::push(L, data);
+        return 1;
+    }
+
+    // yg.flavor.getVec3Into(nameOrHandle, v), writes into existing yg.math.Vec3 or table
+    int flavor_getVec3Into(lua_State *L)
+    {
+        glm::vec3 data(0.0f);
+        int h = toFlavorHandle(L, 1);
+        if (h >= 0 && g_flavorParams.param(h).type == FlavorStore::Type::VEC3)
         {
-            data[0] = g_flavor[name]["data"][0].get<float>();
-            data[1] = g_flavor[name]["data"][1].get<float>();
-            data[2] = g_flavor[name]["data"][2].get<float>();
+            data = glm::vec3(g_flavorParams.param(h).data[0],
+                             g_flavorParams.param(h).data[1],
+                             g_flavorParams.param(h).data[2]);
         }
-        return data;
+        writeVec3(L, 2, data);
+        lua_settop(L, 2);
+        return 1;
     }
 
-    float flavor_getNumber(std::string name)
+    int flavor_getNumber(lua_State *L)
     {
         float data = 0.0f;
-        if (g_flavor.contains(name) &&
-            g_flavor[name]["type"].get<std::string>().compare("number") == 0)
+        int h = toFlavorHandle(L, 1);
+        if (h >= 0 && g_flavorParams.param(h).type == FlavorStore::Type::NUMBER)
         {
-            data = g_flavor[name]["data"].get<float>();
+            data = g_flavorParams.param(h).data[0];
         }
-        return data;
+        lua_pushnumber(L, data);
+        return 1;
     }
 
     void registerLua(lua_State *L)
     {
+        // platform services: yg.audio, yg.control
+        host::registerLua(L);
+
         luabridge::getGlobalNamespace(L)
             .beginNamespace("yg")
-            // namespace audio ...
-            .beginNamespace("audio")
-            .addFunction("init", yg::audio::init)
-            .addFunction("shutdown", yg::audio::shutdown)
-            .addFunction("isInitialized", yg::audio::isInitialized)
-            .addFunction("storeFile", yg::audio::storeFile)
-            .addFunction("play", yg::audio::play)
-            .addFunction("stop", yg::audio::stop)
-            .addFunction("pause", yg::audio::pause)
-            .addFunction("setChannelGains", yg::audio::setChannelGains)
-            .endNamespace()
             // namespace log ...
             .beginNamespace("log")
             .addFunction("debug", log_debug)
@@ -413,19 +536,13 @@ namespace mygame
             .addFunction("warn", log_warn)
             .addFunction("error", log_error)
             .endNamespace()
-            // namespace control ...
-            .beginNamespace("control")
-            .addFunction("exit", yg::control::exit)
-            .addFunction("sendCmdToEnv", yg::control::sendCmdToEnv)
-            .addFunction("enableFullscreen", yg::control::enableFullscreen)
-            .addFunction("enableVSync", yg::control::enableVSync)
-            .addFunction("catchMouse", yg::control::catchMouse)
-            .endNamespace()
             // namespace input ...
             .beginNamespace("input")
+            .addFunction("source", input_source)
             .addFunction("get", input_get)
             .addFunction("geti", input_geti)
             .addFunction("getDelta", input_getDelta)
+            .addFunction("snapshot", input_snapshot)
             .endNamespace()
             // namespace math ...
             .beginNamespace("math")
@@ -448,9 +565,32 @@ namespace mygame
             .addConstructor<void (*)()>()
             .addFunction("rotateLocal", &YgifTrafo::rotateLocal)
             .addFunction("rotateGlobal", &YgifTrafo::rotateGlobal)
+            .addFunction("rotateEuler", &YgifTrafo::rotateEuler)
+            .addFunction("setTRS", &YgifTrafo::setTRS)
             .addFunction("translateLocal", &YgifTrafo::translateLocal)
             .addFunction("translateGlobal", &YgifTrafo::translateGlobal)
             .addFunction("setScaleLocal", &YgifTrafo::setScaleLocal)
+            .addFunction("getEyeInto", &YgifTrafo::getEyeInto)
+            .addFunction("getScaleInto", &YgifTrafo::getScaleInto)
+            .addFunction("getRotationInto", &YgifTrafo::getRotationInto)
+            .addFunction("getAxisLocalInto", &YgifTrafo::getAxisLocalInto)
+            .addFunction("getAxisGlobalInto", &YgifTrafo::getAxisGlobalInto)
+            .endClass()
+            .beginClass<TrafoPool>("TrafoPool")
+            .addConstructor<void (*)(int)>()
+            .addFunction("size", &TrafoPool::size)
+            .addFunction("setTranslation", &TrafoPool::setTranslation)
+            .addFunction("setRotation", &TrafoPool::setRotation)
+            .addFunction("setScale", &TrafoPool::setScale)
+            .addFunction("setRotationRate", &TrafoPool::setRotationRate)
+            .addFunction("setTarget", &TrafoPool::setTarget)
+            .addFunction("getTranslation", &TrafoPool::getTranslation)
+            .addFunction("getRotation", &TrafoPool::getRotation)
+            .addFunction("getScale", &TrafoPool::getScale)
+            .addFunction("getTranslationInto", &TrafoPool::getTranslationInto)
+            .addFunction("translateAll", &TrafoPool::translateAll)
+            .addFunction("rotateAll", &TrafoPool::rotateAll)
+            .addFunction("lerpToTargets", &TrafoPool::lerpToTargets)
             .endClass()
             // Lua class yg.math.Camera (C++ class YgifCamera) is derived from yg::math::Camera
             .beginClass<yg::math::Camera>("CameraBase")
@@ -467,37 +607,99 @@ namespace mygame
             .addConstructor<void (*)()>()
             .addFunction("trafo", &YgifCamera::trafo)
             .addFunction("castRay", &YgifCamera::castRay)
+            .addFunction("castRayInto", &YgifCamera::castRayInto)
             .endClass()
+            .beginClass<PickScene>("PickScene")
+            .addConstructor<void (*)()>()
+            .addFunction("addBox", &PickScene::addBox)
+            .addFunction("addSphere", &PickScene::addSphere)
+            .addFunction("addGeometry", &PickScene::addGeometry)
+            .addFunction("addPool", &PickScene::addPool)
+            .addFunction("remove", &PickScene::remove)
+            .addFunction("pick", &PickScene::pick)
+            .addFunction("raycast", &PickScene::raycast)
+            .addFunction("raycastBatch", &PickScene::raycastBatch)
+            .addFunction("update", &PickScene::update)
+            .addFunction("size", &PickScene::size)
+            .endClass()
+            .endNamespace()
+            // namespace audio (further functions registered by host::registerLua()) ...
+            .beginNamespace("audio")
+            .addFunction("storeFile", audio_storeFile)
+            .addFunction("storeFileAsync", storeAudioFileAsync)
+            .endNamespace()
+            // namespace resources ...
+            .beginNamespace("resources")
+            .addFunction("stats", resources_stats)
+            .endNamespace()
+            // namespace memory ...
+            .beginNamespace("memory")
+            .addFunction("stats", memory_stats)
+            .endNamespace()
+            // namespace task ...
+            .beginNamespace("task")
+            .addFunction("spawn", task_spawn)
+            .addFunction("cancel", task_cancel)
+            .addFunction("wait", task_wait)
+            .addFunction("waitFrames", task_waitFrames)
+            .addFunction("waitUntil", task_waitUntil)
             .endNamespace()
             // namespace time ...
             .beginNamespace("time")
-            .addFunction("getClockPeriod", yg::time::getClockPeriod)
-            .addFunction("getDelta", yg::time::getDelta)
-            .addFunction("getTime", yg::time::getTime)
+            .addFunction("getClockPeriod", host::timeGetClockPeriod)
+            .addFunction("getDelta", host::timeGetDelta)
+            .addFunction("getTime", host::timeGetTime)
             .endNamespace()
             // namespace gl ...
             .beginNamespace("gl")
             .addFunction("draw", gl_draw)
-            .addFunction("loadGeometry", yg::gl::loadGeometry)
+            .addFunction("stateStats", gl_stateStats)
+            .addFunction("loadGeometry", loadGeometry)
             .addFunction("loadVertFragShader", loadVertFragShader)
+            .addFunction("releaseGeometry", releaseResource<yg::gl::Geometry>)
+            .addFunction("releaseShader", releaseResource<yg::gl::Shader>)
+            .addFunction("loadGeometryAsync", loadGeometryAsync)
+            .addFunction("loadVertFragShaderAsync", loadVertFragShaderAsync)
+            .beginClass<LoadHandle>("LoadHandle")
+            .addFunction("isReady", &LoadHandle::isReady)
+            .addFunction("get", &LoadHandle::get)
+            .endClass()
             .beginClass<yg::gl::Geometry>("Geometry")
             .endClass()
-            .beginClass<yg::gl::Lightsource>("Lightsource")
+            // Lua class yg.gl.Lightsource (C++ class YgifLightsource) is derived from yg::gl::Lightsource
+            .beginClass<yg::gl::Lightsource>("LightsourceBase")
+            .endClass()
+            .deriveClass<YgifLightsource, yg::gl::Lightsource>("Lightsource")
             .addConstructor<void (*)()>()
-            .addFunction("setAmbient", &yg::gl::Lightsource::setAmbient)
-            .addFunction("setDiffuse", &yg::gl::Lightsource::setDiffuse)
-            .addFunction("setSpecular", &yg::gl::Lightsource::setSpecular)
-            .addFunction("setPosition", &yg::gl::Lightsource::setPosition)
+            .addFunction("setAmbient", &YgifLightsource::setAmbient)
+            .addFunction("setDiffuse", &YgifLightsource::setDiffuse)
+            .addFunction("setSpecular", &YgifLightsource::setSpecular)
+            .addFunction("setPosition", &YgifLightsource::setPosition)
             .endClass()
             .beginClass<yg::gl::Shader>("Shader")
             .endClass()
+            .beginClass<DrawList>("DrawList")
+            .addConstructor<void (*)()>()
+            .addFunction("add", &DrawList::add)
+            .addFunction("addPool", &DrawList::addPool)
+            .addFunction("setInstancedShader", &DrawList::setInstancedShader)
+            .addFunction("flush", &DrawList::flush)
+            .addFunction("clear", &DrawList::clear)
+            .addFunction("size", &DrawList::size)
+            .endClass()
             .endNamespace()
             // namespace flavor ...
             .beginNamespace("flavor")
+            .addFunction("handle", flavor_handle)
             .addFunction("getVec3", flavor_getVec3)
+            .addFunction("getVec3Into", flavor_getVec3Into)
             .addFunction("getNumber", flavor_getNumber)
             .endNamespace()
             // end of namespace yg
             .endNamespace();
+
+        registerInputConstants(L);
+        registerVecMath(L);
+        registerTrafoConstants(L);
     }
 }
@@ -20,6 +20,9 @@ freely, subject to the following restrictions:
 #ifndef YGIF_GLUE_H
 #define YGIF_GLUE_H
 
+#include <cstddef>
+#include "yourgame/yourgame.h"
+
 extern "C"
 {
 #include "lua.h"
@@ -28,6 +31,29 @@ extern "C"
 namespace mygame
 {
     void registerLua(lua_State *L);
+
+    // push a resource of g_resources (or nil): all references to it in Lua
+    // share one userdata, which yg.gl.releaseGeometry()/releaseShader()
+    // invalidate when they free the resource
+    void pushGeometry(lua_State *L, yourgame::gl::Geometry *geo);
+    void pushShader(lua_State *L, yourgame::gl::Shader *shader);
+
+    // sets n fields of the namespace table yg.<ns>, after registerLua().
+    // raw access: LuaBridge namespace tables have a __newindex metamethod.
+    // pushField(L, i) pushes the name and the value of field i
+    template <class PushField>
+    void setYgFields(lua_State *L, char const *ns, std::size_t n, PushField pushField)
+    {
+        lua_getglobal(L, "yg");
+        lua_pushstring(L, ns);
+        lua_rawget(L, -2);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            pushField(L, i);
+            lua_rawset(L, -3);
+        }
+        lua_pop(L, 2);
+    }
 }
 
 #endif
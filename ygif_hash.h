@@ -0,0 +1,25 @@
+#ifndef YGIF_HASH_H
+#define YGIF_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mygame
+{
+    uint64_t const fnv1a64Basis = 14695981039346656037ull;
+
+    // 64 bit FNV-1a of size bytes at data. pass the result as h to continue
+    // hashing over multiple buffers
+    inline uint64_t hashFnv1a64(void const *data, std::size_t size, uint64_t h = fnv1a64Basis)
+    {
+        uint8_t const *bytes = static_cast<uint8_t const *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+}
+
+#endif
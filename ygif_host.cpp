@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "ygif_host.h"
+#include "ygif_glstate.h"
+#include "ygif_draw.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace host
+    {
+        float inputGet(yg::input::Source source)
+        {
+            return yg::input::get(source);
+        }
+
+        int inputGeti(yg::input::Source source)
+        {
+            return yg::input::geti(source);
+        }
+
+        float inputGetDelta(yg::input::Source source)
+        {
+            return yg::input::getDelta(source);
+        }
+
+        double timeGetDelta()
+        {
+            return yg::time::getDelta();
+        }
+
+        double timeGetTime()
+        {
+            return yg::time::getTime();
+        }
+
+        double timeGetClockPeriod()
+        {
+            return yg::time::getClockPeriod();
+        }
+
+        yg::gl::Geometry *loadGeometry(std::string const &filename)
+        {
+            return yg::gl::loadGeometry(filename);
+        }
+
+        yg::gl::Shader *loadVertFragShader(std::string const &vertFilename, std::string const &fragFilename)
+        {
+            return yg::gl::loadShader({{GL_VERTEX_SHADER, vertFilename},
+                                       {GL_FRAGMENT_SHADER, fragFilename}});
+        }
+
+        yg::gl::Geometry *makeGeometry(MeshView const &mesh)
+        {
+            MeshHeader const &h = *mesh.header;
+            yg::gl::Buffer *vbo = yg::gl::Buffer::make(GL_ARRAY_BUFFER,
+                                                       static_cast<GLsizeiptr>(h.vertexCount * sizeof(MeshVertex)),
+                                                       mesh.vertices,
+                                                       GL_STATIC_DRAW);
+            yg::gl::Buffer *ibo = yg::gl::Buffer::make(GL_ELEMENT_ARRAY_BUFFER,
+                                                       static_cast<GLsizeiptr>(h.indexCount * sizeof(uint32_t)),
+                                                       mesh.indices,
+                                                       GL_STATIC_DRAW);
+            if (vbo == nullptr || ibo == nullptr)
+            {
+                delete vbo;
+                delete ibo;
+                return nullptr;
+            }
+
+            // attribute locations of default.vert
+            GLsizei stride = static_cast<GLsizei>(sizeof(MeshVertex));
+            std::vector<yg::gl::Shape::ArrBufferDescr> attrs = {
+                {vbo, 0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void *>(offsetof(MeshVertex, position)), 0},
+                {vbo, 1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void *>(offsetof(MeshVertex, normal)), 0},
+                {vbo, 2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void *>(offsetof(MeshVertex, texcoords)), 0},
+                {vbo, 3, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void *>(offsetof(MeshVertex, color)), 0}};
+            yg::gl::Shape *shape = yg::gl::Shape::make(attrs,
+                                                       ibo,
+                                                       (h.primitive == MESH_LINES) ? GL_LINES : GL_TRIANGLES,
+                                                       static_cast<GLsizei>(h.indexCount),
+                                                       GL_UNSIGNED_INT);
+
+            yg::gl::Geometry *geo = new yg::gl::Geometry();
+            geo->addBuffer("vertices", vbo);
+            geo->addBuffer("indices", ibo);
+            if (shape == nullptr || !geo->addShape("mesh", shape))
+            {
+                delete shape;
+                delete geo; // deletes the buffers
+                return nullptr;
+            }
+            return geo;
+        }
+
+        void freeGeometry(yg::gl::Geometry *geo)
+        {
+            delete geo;
+        }
+
+        void freeShader(yg::gl::Shader *shader)
+        {
+            g_glState.forgetProgram(shader);
+            delete shader;
+        }
+
+        bool audioStoreFile(std::string const &filename)
+        {
+            return yg::audio::storeFile(filename);
+        }
+
+        void useProgram(yg::gl::Shader *shader,
+                        yg::gl::Lightsource *light,
+                        yg::math::Camera *camera)
+        {
+            // binds the program, uploads the light and camera uniforms
+            // (if not null). skipped as far as the program has them already
+            GlStateCache::Action a = g_glState.use(shader, light, camera);
+            if (a.bind || a.uploadLight || a.uploadCamera)
+            {
+                shader->useProgram(a.uploadLight ? light : nullptr, a.uploadCamera ? camera : nullptr);
+            }
+        }
+
+        void drawGeo(yg::gl::Geometry *geo, yg::gl::DrawConfig const &cfg)
+        {
+            yg::gl::drawGeo(geo, cfg);
+        }
+
+        void uploadInstanceModelMats(yg::gl::Shader *instancedShader, glm::mat4 const *mats, int n)
+        {
+            // normal matrices per instance, not per vertex in the shader
+            glm::mat3 normalMats[DrawList::maxInstancesPerDraw];
+            n = std::min(n, DrawList::maxInstancesPerDraw);
+            for (int i = 0; i < n; ++i)
+            {
+                normalMats[i] = glm::transpose(glm::inverse(glm::mat3(mats[i])));
+            }
+            glUniformMatrix4fv(g_glState.uniformLocation(instancedShader, "instModelMats"),
+                               static_cast<GLsizei>(n), GL_FALSE, &(mats[0][0][0]));
+            glUniformMatrix3fv(g_glState.uniformLocation(instancedShader, "instNormalMats"),
+                               static_cast<GLsizei>(n), GL_FALSE, &(normalMats[0][0][0]));
+        }
+
+        void registerLua(lua_State *L)
+        {
+            luabridge::getGlobalNamespace(L)
+                .beginNamespace("yg")
+                // namespace audio ...
+                .beginNamespace("audio")
+                .addFunction("init", yg::audio::init)
+                .addFunction("shutdown", yg::audio::shutdown)
+                .addFunction("isInitialized", yg::audio::isInitialized)
+                .addFunction("play", yg::audio::play)
+                .addFunction("stop", yg::audio::stop)
+                .addFunction("pause", yg::audio::pause)
+                .addFunction("setChannelGains", yg::audio::setChannelGains)
+                .endNamespace()
+                // namespace control ...
+                .beginNamespace("control")
+                .addFunction("exit", yg::control::exit)
+                .addFunction("sendCmdToEnv", yg::control::sendCmdToEnv)
+                .addFunction("enableFullscreen", yg::control::enableFullscreen)
+                .addFunction("enableVSync", yg::control::enableVSync)
+                .addFunction("catchMouse", yg::control::catchMouse)
+                .endNamespace()
+                // end of namespace yg
+                .endNamespace();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef YGIF_HOST_H
+#define YGIF_HOST_H
+
+#include <string>
+#include "yourgame/yourgame.h"
+#include "ygif_mesh.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // platform services used by the Lua glue (input, time, drawing, audio, control).
+    // ygif_host.cpp forwards them to yourgame. the headless benchmark
+    // (bench/ygif_bench_host.cpp) provides a replacement that needs no window,
+    // GL context or audio device.
+    namespace host
+    {
+        float inputGet(yourgame::input::Source source);
+        int inputGeti(yourgame::input::Source source);
+        float inputGetDelta(yourgame::input::Source source);
+
+        double timeGetDelta();
+        double timeGetTime();
+        double timeGetClockPeriod();
+
+        yourgame::gl::Geometry *loadGeometry(std::string const &filename);
+        yourgame::gl::Shader *loadVertFragShader(std::string const &vertFilename, std::string const &fragFilename);
+
+        // creates a Geometry from a binary mesh: one vertex and one index buffer,
+        // uploaded as they are
+        yourgame::gl::Geometry *makeGeometry(MeshView const &mesh);
+
+        void freeGeometry(yourgame::gl::Geometry *geo);
+        void freeShader(yourgame::gl::Shader *shader);
+        bool audioStoreFile(std::string const &filename);
+
+        void useProgram(yourgame::gl::Shader *shader,
+                        yourgame::gl::Lightsource *light,
+                        yourgame::math::Camera *camera);
+        void drawGeo(yourgame::gl::Geometry *geo, yourgame::gl::DrawConfig const &cfg);
+
+        // uploads n model matrices to the instModelMats[] uniform array of
+        // instancedShader, which has to be the current program, and their
+        // normal matrices to instNormalMats[]
+        void uploadInstanceModelMats(yourgame::gl::Shader *instancedShader, glm::mat4 const *mats, int n);
+
+        // registers the Lua namespaces yg.audio (except storeFile(), which goes
+        // through the resource cache) and yg.control
+        void registerLua(lua_State *L);
+    }
+}
+
+#endif
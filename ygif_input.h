@@ -0,0 +1,39 @@
+#ifndef YGIF_INPUT_H
+#define YGIF_INPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "yourgame/input.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    struct InputSourceName
+    {
+        const char *name;
+        yourgame::input::Source source;
+    };
+
+    // returns the table of all input sources known to Lua,
+    // count is set to the number of entries
+    const InputSourceName *getInputSourceNames(std::size_t &count);
+
+    // looks up an input source by its name (not necessarily null-terminated),
+    // returns false if the name is unknown
+    bool findInputSource(const char *name, std::size_t len, yourgame::input::Source &src);
+
+    // reads an input source from the Lua stack at idx. accepts a source handle
+    // (integer, see yg.input.source()) or a source name (string).
+    // returns false if the value is neither a valid handle nor a known name
+    bool toInputSource(lua_State *L, int idx, yourgame::input::Source &src);
+
+    // converts a source handle (see yg.input.source()), returns false if it
+    // is not valid
+    bool toInputSource(lua_Integer handle, yourgame::input::Source &src);
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include "yourgame/yourgame.h"
+#include "ygif_jobs.h"
+
+namespace mygame
+{
+    JobPool::JobPool(unsigned numWorkers)
+    {
+        for (unsigned i = 0; i < numWorkers; ++i)
+        {
+            m_workers.emplace_back(&JobPool::workerLoop, this);
+        }
+    }
+
+    JobPool::~JobPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_jobs.clear();
+        }
+        m_cv.notify_all();
+        for (auto &w : m_workers)
+        {
+            w.join();
+        }
+    }
+
+    void JobPool::submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+    void JobPool::runPending(double budgetSeconds)
+    {
+        if (!m_workers.empty())
+        {
+            return;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_jobs.empty())
+                {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+
+            if (std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() >= budgetSeconds)
+            {
+                return;
+            }
+        }
+    }
+
+    void JobPool::workerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+                if (m_stop)
+                {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    JobPool &getJobPool()
+    {
+#if defined(YOURGAME_PLATFORM_WEB)
+        static JobPool pool(0u);
+#else
+        static JobPool pool(std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1u, 4u));
+#endif
+        return pool;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef YGIF_JOBS_H
+#define YGIF_JOBS_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mygame
+{
+    // fixed-size pool of worker threads, running jobs in submission order.
+    // with 0 workers (platforms without threads), jobs are run on the calling
+    // thread by runPending().
+    class JobPool
+    {
+    public:
+        explicit JobPool(unsigned numWorkers);
+        JobPool(JobPool const &) = delete;
+        JobPool &operator=(JobPool const &) = delete;
+
+        // drops jobs not started yet, waits for running jobs
+        ~JobPool();
+
+        void submit(std::function<void()> job);
+
+        // runs queued jobs on the calling thread, until budgetSeconds are
+        // used (at least one job). does nothing if the pool has workers
+        void runPending(double budgetSeconds);
+
+        unsigned numWorkers() const { return static_cast<unsigned>(m_workers.size()); }
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_stop = false;
+    };
+
+    // the pool used for asset loading and file reads: 1 to 4 workers,
+    // 0 on web
+    JobPool &getJobPool();
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include "ygif_light.h"
+#include "ygif_glstate.h"
+
+namespace mygame
+{
+    YgifLightsource::YgifLightsource()
+    {
+        g_glState.touchLight(this);
+    }
+
+    YgifLightsource::~YgifLightsource()
+    {
+        g_glState.forgetLight(this);
+    }
+
+    void YgifLightsource::setAmbient(glm::vec3 const &ambient)
+    {
+        yourgame::gl::Lightsource::setAmbient(ambient);
+        g_glState.touchLight(this);
+    }
+
+    void YgifLightsource::setDiffuse(glm::vec3 const &diffuse)
+    {
+        yourgame::gl::Lightsource::setDiffuse(diffuse);
+        g_glState.touchLight(this);
+    }
+
+    void YgifLightsource::setSpecular(glm::vec3 const &specular)
+    {
+        yourgame::gl::Lightsource::setSpecular(specular);
+        g_glState.touchLight(this);
+    }
+
+    void YgifLightsource::setPosition(glm::vec3 const &position)
+    {
+        yourgame::gl::Lightsource::setPosition(position);
+        g_glState.touchLight(this);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef YGIF_LIGHT_H
+#define YGIF_LIGHT_H
+
+#include "yourgame/yourgame.h"
+
+namespace mygame
+{
+    // Lua class yg.gl.Lightsource: reports changes to g_glState, light
+    // uniforms are uploaded only after a change
+    class YgifLightsource : public yourgame::gl::Lightsource
+    {
+    public:
+        YgifLightsource();
+        ~YgifLightsource();
+        YgifLightsource(YgifLightsource const &) = delete;
+        YgifLightsource &operator=(YgifLightsource const &) = delete;
+
+        void setAmbient(glm::vec3 const &ambient);
+        void setDiffuse(glm::vec3 const &diffuse);
+        void setSpecular(glm::vec3 const &specular);
+        void setPosition(glm::vec3 const &position);
+    };
+}
+
+#endif
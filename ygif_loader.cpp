@@ -0,0 +1,236 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_loader.h"
+#include "ygif_hash.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        // cache file layout: magic, 64 bit FNV-1a hash of the source, bytecode
+        char const cacheMagic[4] = {'Y', 'G', 'B', 'C'};
+        std::size_t const cacheHeaderSize = sizeof(cacheMagic) + sizeof(uint64_t);
+
+        std::vector<LuaChunkInfo> g_chunks;
+
+        void trackChunk(std::string const &filename, std::string const &modName, uint64_t hash)
+        {
+            for (auto &c : g_chunks)
+            {
+                if (c.filename == filename)
+                {
+                    c.modName = modName;
+                    c.hash = hash;
+                    return;
+                }
+            }
+            g_chunks.push_back({filename, modName, hash});
+        }
+
+        uint64_t hashSource(std::vector<uint8_t> const &src)
+        {
+            return src.empty() ? fnv1a64Basis : hashFnv1a64(&src[0], src.size());
+        }
+
+        bool hasProjectPath()
+        {
+            return yg::file::getProjectFilePath("") != "";
+        }
+
+        // "a//sub/x.lua" -> "s//.luacache_a__sub_x.lua.bc". always in the
+        // savefiles directory: the project directory is the user's, and is watched
+        std::string getCacheFilename(std::string const &filename)
+        {
+            std::string name = filename;
+            for (auto &c : name)
+            {
+                if (c == '/' || c == '\\' || c == ':')
+                {
+                    c = '_';
+                }
+            }
+            return "s//.luacache_" + name + ".bc";
+        }
+
+        int bytecodeWriter(lua_State *L, const void *p, size_t sz, void *ud)
+        {
+            (void)L;
+            std::vector<uint8_t> *out = static_cast<std::vector<uint8_t> *>(ud);
+            out->insert(out->end(), static_cast<uint8_t const *>(p), static_cast<uint8_t const *>(p) + sz);
+            return 0;
+        }
+
+        // pushes the chunk from the cache file, if it exists and matches hash
+        bool loadFromCache(lua_State *L, std::string const &cacheName, std::string const &chunkName, uint64_t hash)
+        {
+            std::vector<uint8_t> data;
+            if (yg::file::readFile(cacheName, data) != 0 ||
+                data.size() <= cacheHeaderSize ||
+                std::memcmp(&data[0], cacheMagic, sizeof(cacheMagic)) != 0)
+            {
+                return false;
+            }
+
+            uint64_t cachedHash;
+            std::memcpy(&cachedHash, &data[sizeof(cacheMagic)], sizeof(cachedHash));
+            if (cachedHash != hash)
+            {
+                return false;
+            }
+
+            // bytecode of a different Lua version/build is rejected by the loader
+            if (luaL_loadbufferx(L,
+                                 reinterpret_cast<char const *>(&data[cacheHeaderSize]),
+                                 data.size() - cacheHeaderSize,
+                                 chunkName.c_str(),
+                                 "b") != LUA_OK)
+            {
+                lua_pop(L, 1); // error message
+                return false;
+            }
+            return true;
+        }
+
+        // dumps the chunk on top of the stack into the cache file
+        void writeCache(lua_State *L, std::string const &cacheName, uint64_t hash)
+        {
+            std::vector<uint8_t> data(cacheMagic, cacheMagic + sizeof(cacheMagic));
+            data.resize(cacheHeaderSize);
+            std::memcpy(&data[sizeof(cacheMagic)], &hash, sizeof(hash));
+
+#if LUA_VERSION_NUM >= 503
+            int dumpErr = lua_dump(L, bytecodeWriter, &data, 0);
+#else
+            int dumpErr = lua_dump(L, bytecodeWriter, &data);
+#endif
+            if (dumpErr != 0 || yg::file::writeFile(cacheName, &data[0], data.size()) != 0)
+            {
+                yg::log::warn("failed to write Lua bytecode cache %v", cacheName);
+            }
+        }
+
+        int luaSearcher(lua_State *L)
+        {
+            std::string modName = luaL_checkstring(L, 1);
+            for (auto &c : modName)
+            {
+                if (c == '.')
+                {
+                    c = '/';
+                }
+            }
+
+            std::string candidates[2] = {"p//" + modName + ".lua", "a//" + modName + ".lua"};
+            std::string notFound;
+            for (int i = hasProjectPath() ? 0 : 1; i < 2; ++i)
+            {
+                int status = loadLuaChunk(L, candidates[i], lua_tostring(L, 1));
+                if (status == LUA_ERRFILE)
+                {
+                    lua_pop(L, 1); // error message
+                    notFound += "\n\tno file '" + candidates[i] + "'";
+                    continue;
+                }
+                else if (status != LUA_OK)
+                {
+                    return luaL_error(L, "error loading module '%s' from file '%s':\n\t%s",
+                                      lua_tostring(L, 1), candidates[i].c_str(), lua_tostring(L, -1));
+                }
+                // loader, and file name passed to the loader as 2nd argument
+                lua_pushstring(L, candidates[i].c_str());
+                return 2;
+            }
+
+            lua_pushstring(L, notFound.c_str());
+            return 1;
+        }
+    }
+
+    int loadLuaChunk(lua_State *L, std::string const &filename, std::string const &modName)
+    {
+        std::vector<uint8_t> src;
+        if (yg::file::readFile(filename, src) != 0)
+        {
+            lua_pushfstring(L, "cannot read %s", filename.c_str());
+            return LUA_ERRFILE;
+        }
+
+        std::string chunkName = "@" + filename;
+        std::string cacheName = getCacheFilename(filename);
+        uint64_t hash = hashSource(src);
+
+        trackChunk(filename, modName, hash);
+
+        if (loadFromCache(L, cacheName, chunkName, hash))
+        {
+            return LUA_OK;
+        }
+
+        // stale or missing cache: compile source, refresh cache
+        int status = luaL_loadbufferx(L,
+                                      src.empty() ? "" : reinterpret_cast<char const *>(&src[0]),
+                                      src.size(),
+                                      chunkName.c_str(),
+                                      "t");
+        if (status == LUA_OK)
+        {
+            writeCache(L, cacheName, hash);
+        }
+        return status;
+    }
+
+    std::vector<LuaChunkInfo> const &getLuaChunks()
+    {
+        return g_chunks;
+    }
+
+    void clearLuaChunks()
+    {
+        g_chunks.clear();
+    }
+
+    bool luaChunkChanged(LuaChunkInfo const &chunk)
+    {
+        std::vector<uint8_t> src;
+        if (yg::file::readFile(chunk.filename, src) != 0)
+        {
+            return false; // removed or not readable: keep the loaded version
+        }
+        return hashSource(src) != chunk.hash;
+    }
+
+    void registerLuaSearcher(lua_State *L)
+    {
+        lua_getglobal(L, "package");
+#if LUA_VERSION_NUM >= 502
+        lua_getfield(L, -1, "searchers");
+        int n = lua_istable(L, -1) ? static_cast<int>(lua_rawlen(L, -1)) : 0;
+#else
+        lua_getfield(L, -1, "loaders");
+        int n = lua_istable(L, -1) ? static_cast<int>(lua_objlen(L, -1)) : 0;
+#endif
+        if (n > 0)
+        {
+            // insert at position 2, after the package.preload searcher
+            for (int i = n; i >= 2; --i)
+            {
+                lua_rawgeti(L, -1, i);
+                lua_rawseti(L, -2, i + 1);
+            }
+            lua_pushcfunction(L, luaSearcher);
+            lua_rawseti(L, -2, 2);
+        }
+        lua_pop(L, 2);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef YGIF_LOADER_H
+#define YGIF_LOADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // loads the Lua chunk filename (yg::file path, "a//..." or "p//...") and
+    // pushes it as function. returns LUA_OK, or an error status with the error
+    // message pushed instead.
+    //
+    // the compiled chunk is cached as bytecode (lua_dump()) in the savefiles
+    // directory (s//), never in the project directory. the cache is keyed by
+    // a hash of the source and recompiled if stale.
+    //
+    // modName is the require() name of the chunk, empty for the main script.
+    int loadLuaChunk(lua_State *L, std::string const &filename, std::string const &modName = "");
+
+    // a chunk loaded via loadLuaChunk(), tracked for hot reload
+    struct LuaChunkInfo
+    {
+        std::string filename;
+        std::string modName;
+        uint64_t hash; // of the source, as loaded
+    };
+
+    std::vector<LuaChunkInfo> const &getLuaChunks();
+    void clearLuaChunks();
+
+    // returns true if the current source of chunk differs from the loaded one
+    bool luaChunkChanged(LuaChunkInfo const &chunk);
+
+    // adds a package searcher for require("a.b"), that loads a/b.lua via
+    // loadLuaChunk() from p// (if a project path is set) and a//
+    void registerLuaSearcher(lua_State *L);
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "ygif_luaalloc.h"
+
+namespace mygame
+{
+    namespace
+    {
+        // size class of a small block, its blocks have (cls + 1) * 16 bytes
+        std::size_t sizeClass(std::size_t size)
+        {
+            return (size - 1) / 16;
+        }
+    }
+
+    std::size_t const LuaAllocator::maxSmallSize;
+    std::size_t const LuaAllocator::chunkSize;
+    std::size_t const LuaAllocator::numClasses;
+
+    LuaAllocator::~LuaAllocator()
+    {
+        reset();
+    }
+
+    void *LuaAllocator::alloc(void *ud, void *ptr, std::size_t osize, std::size_t nsize)
+    {
+        LuaAllocator *a = static_cast<LuaAllocator *>(ud);
+        Stats &s = a->m_stats;
+
+        // without ptr, osize is the type of the new object, not a size
+        std::size_t old = (ptr != nullptr) ? osize : 0;
+
+        if (nsize == 0)
+        {
+            if (ptr != nullptr)
+            {
+                a->freeBlock(ptr, old);
+                s.liveBytes -= old;
+                ++s.frees;
+            }
+            return nullptr;
+        }
+
+        if (nsize > old && a->m_limit > 0 && s.liveBytes + (nsize - old) > a->m_limit)
+        {
+            ++s.failedAllocs;
+            return nullptr;
+        }
+
+        void *p = nullptr;
+        bool oldSmall = (ptr != nullptr) && (old <= maxSmallSize);
+        bool newSmall = (nsize <= maxSmallSize);
+        if (oldSmall && newSmall && sizeClass(old) == sizeClass(nsize))
+        {
+            p = ptr;
+        }
+        else if (ptr != nullptr && !oldSmall && !newSmall)
+        {
+            p = std::realloc(ptr, nsize);
+            ++s.systemAllocs;
+        }
+        else
+        {
+            // new block, or moved between the freelists and the system heap
+            if (newSmall)
+            {
+                p = a->allocSmall(nsize);
+            }
+            else
+            {
+                p = std::malloc(nsize);
+                ++s.systemAllocs;
+            }
+            if (p != nullptr && ptr != nullptr)
+            {
+                std::memcpy(p, ptr, std::min(old, nsize));
+                a->freeBlock(ptr, old);
+            }
+        }
+
+        if (p == nullptr)
+        {
+            if (ptr != nullptr && nsize <= old)
+            {
+                // shrinking must not fail: keep the larger block. a small one
+                // is freed into a smaller (or its own) class later, a system
+                // block is remembered to go back to free()
+                p = ptr;
+                if (!oldSmall && newSmall)
+                {
+                    try
+                    {
+                        a->m_systemSmall.insert(ptr);
+                    }
+                    catch (std::bad_alloc const &)
+                    {
+                        // out of system memory: the block leaks on reset()
+                    }
+                }
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        s.liveBytes = s.liveBytes - old + nsize;
+        s.peakBytes = std::max(s.peakBytes, s.liveBytes);
+        if (nsize > old)
+        {
+            ++s.allocs;
+        }
+        return p;
+    }
+
+    void LuaAllocator::beginTick()
+    {
+        m_lastTick = m_stats;
+        m_stats.allocs = 0;
+        m_stats.frees = 0;
+        m_stats.systemAllocs = 0;
+    }
+
+    void LuaAllocator::reset()
+    {
+        for (void *c : m_chunks)
+        {
+            std::free(c);
+        }
+        m_chunks.clear();
+        for (void *p : m_systemSmall)
+        {
+            std::free(p);
+        }
+        m_systemSmall.clear();
+        std::fill(m_free, m_free + numClasses, nullptr);
+        m_stats = Stats();
+        m_lastTick = Stats();
+    }
+
+    void *LuaAllocator::allocSmall(std::size_t size)
+    {
+        std::size_t cls = sizeClass(size);
+        if (m_free[cls] == nullptr && !refill(cls))
+        {
+            return nullptr;
+        }
+        FreeBlock *b = m_free[cls];
+        m_free[cls] = b->next;
+        return b;
+    }
+
+    void LuaAllocator::freeBlock(void *ptr, std::size_t size)
+    {
+        if (size > maxSmallSize)
+        {
+            std::free(ptr);
+        }
+        else if (!m_systemSmall.empty() && m_systemSmall.erase(ptr) > 0)
+        {
+            std::free(ptr); // kept by a failed shrink
+        }
+        else
+        {
+            freeSmall(ptr, size);
+        }
+    }
+
+    void LuaAllocator::freeSmall(void *ptr, std::size_t size)
+    {
+        std::size_t cls = sizeClass(size);
+        FreeBlock *b = static_cast<FreeBlock *>(ptr);
+        b->next = m_free[cls];
+        m_free[cls] = b;
+    }
+
+    // a new chunk, split into blocks of the class
+    bool LuaAllocator::refill(std::size_t cls)
+    {
+        char *chunk = static_cast<char *>(std::malloc(chunkSize));
+        if (chunk == nullptr)
+        {
+            return false;
+        }
+        try
+        {
+            m_chunks.push_back(chunk);
+        }
+        catch (std::bad_alloc const &)
+        {
+            // must not throw through lua_Alloc: the allocation fails instead
+            std::free(chunk);
+            return false;
+        }
+        m_stats.chunkBytes += chunkSize;
+        ++m_stats.systemAllocs;
+
+        std::size_t blockSize = (cls + 1) * 16;
+        for (std::size_t off = 0; off + blockSize <= chunkSize; off += blockSize)
+        {
+            freeSmall(chunk + off, blockSize);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef YGIF_LUAALLOC_H
+#define YGIF_LUAALLOC_H
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace mygame
+{
+    // allocator of a Lua state (lua_newstate(LuaAllocator::alloc, &a)).
+    // blocks up to maxSmallSize bytes come from size-class freelists (16 byte
+    // steps), carved from chunks of chunkSize bytes, so the tables and
+    // strings freed by the GC are reused by the next tick without malloc().
+    // larger blocks go to realloc(). chunks are kept until reset().
+    // counts live and peak bytes (as requested by Lua), and allocations per
+    // tick. with a limit set, allocations beyond it fail: Lua runs an
+    // emergency collection, and raises a "not enough memory" error if that
+    // does not help. shrinking and freeing never fail.
+    class LuaAllocator
+    {
+    public:
+        static std::size_t const maxSmallSize = 256;
+        static std::size_t const chunkSize = 16384;
+
+        struct Stats
+        {
+            std::size_t liveBytes = 0;
+            std::size_t peakBytes = 0;
+            std::size_t chunkBytes = 0; // held by the freelists, used or not
+            unsigned long allocs = 0;   // new and grown blocks, current tick
+            unsigned long frees = 0;    // current tick
+            unsigned long systemAllocs = 0; // malloc()/realloc() calls, current tick
+            unsigned long failedAllocs = 0; // beyond the limit, since reset()
+        };
+
+        LuaAllocator() = default;
+        LuaAllocator(LuaAllocator const &) = delete;
+        LuaAllocator &operator=(LuaAllocator const &) = delete;
+        ~LuaAllocator();
+
+        // lua_Alloc, ud: the LuaAllocator
+        static void *alloc(void *ud, void *ptr, std::size_t osize, std::size_t nsize);
+
+        // live bytes allowed, 0: no limit
+        void setLimit(std::size_t bytes) { m_limit = bytes; }
+        std::size_t limit() const { return m_limit; }
+
+        // starts counting the allocations of a new tick, the counts of the
+        // previous one are kept as lastTick()
+        void beginTick();
+
+        Stats const &stats() const { return m_stats; }
+        Stats const &lastTick() const { return m_lastTick; }
+
+        // frees the chunks and clears the stats. only without a Lua state
+        // using the allocator (after lua_close())
+        void reset();
+
+    private:
+        static std::size_t const numClasses = maxSmallSize / 16;
+
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        void *allocSmall(std::size_t size);
+        void freeBlock(void *ptr, std::size_t size); // to the freelists or free()
+        void freeSmall(void *ptr, std::size_t size);
+        bool refill(std::size_t cls);
+
+        FreeBlock *m_free[numClasses] = {};
+        std::vector<void *> m_chunks;
+        std::unordered_set<void *> m_systemSmall; // malloc() blocks of a small size
+        std::size_t m_limit = 0;
+        Stats m_stats;
+        Stats m_lastTick;
+    };
+}
+
+#endif
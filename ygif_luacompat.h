@@ -0,0 +1,68 @@
+#ifndef YGIF_LUACOMPAT_H
+#define YGIF_LUACOMPAT_H
+
+#include <cstddef>
+
+extern "C"
+{
+#include "lua.h"
+}
+
+// Lua 5.2+ API used by the runtime and glue, for Lua 5.1 API backends
+// (LuaJIT, see YGIF_LUAJIT). LuaJIT 2.1 already provides the 5.2 auxiliary
+// functions (luaL_loadbufferx(), luaL_testudata(), luaL_setfuncs(), ...).
+// declared in mygame, like LuaBridge does in luabridge, so unqualified calls
+// from either namespace are not ambiguous.
+#if LUA_VERSION_NUM < 502
+
+#ifndef LUA_OK
+#define LUA_OK 0
+#endif
+
+namespace mygame
+{
+    inline int lua_absindex(lua_State *L, int idx)
+    {
+        return (idx > 0 || idx <= LUA_REGISTRYINDEX) ? idx : lua_gettop(L) + idx + 1;
+    }
+
+    inline std::size_t lua_rawlen(lua_State *L, int idx)
+    {
+        return lua_objlen(L, idx);
+    }
+}
+
+#endif
+
+namespace mygame
+{
+    // main thread of the state of L, for Lua references held beyond the
+    // current call (L may be a coroutine). Lua 5.1 API: L itself
+    inline lua_State *luaMainThread(lua_State *L)
+    {
+#if LUA_VERSION_NUM >= 502
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+        lua_State *main = lua_tothread(L, -1);
+        lua_pop(L, 1);
+        return main;
+#else
+        return L;
+#endif
+    }
+
+    // the number at idx as lua_Integer, if it has an exact integer value.
+    // lua_tointegerx() of Lua 5.2 and LuaJIT truncates fractions, 5.3+ fails
+    inline bool luaToIntegral(lua_State *L, int idx, lua_Integer &out)
+    {
+        int isnum = 0;
+        lua_Integer i = lua_tointegerx(L, idx, &isnum);
+        if (isnum == 0 || static_cast<lua_Number>(i) != lua_tonumber(L, idx))
+        {
+            return false;
+        }
+        out = i;
+        return true;
+    }
+}
+
+#endif
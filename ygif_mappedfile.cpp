@@ -0,0 +1,133 @@
+#include "yourgame/yourgame.h"
+#include "ygif_mappedfile.h"
+
+#if defined(YOURGAME_PLATFORM_DESKTOP)
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    std::string nativeFilePath(std::string const &filename)
+    {
+        if (filename.compare(0, 3, "a//") == 0)
+        {
+#if defined(YOURGAME_PLATFORM_ANDROID)
+            return ""; // packed in the apk
+#else
+            return yg::file::getAssetFilePath(filename.substr(3));
+#endif
+        }
+        else if (filename.compare(0, 3, "p//") == 0)
+        {
+            return (yg::file::getProjectFilePath("") != "") ? yg::file::getProjectFilePath(filename.substr(3)) : "";
+        }
+        else if (filename.compare(0, 3, "s//") == 0)
+        {
+            return yg::file::getSaveFilePath(filename.substr(3));
+        }
+        return "";
+    }
+
+    bool MappedFile::open(std::string const &filename)
+    {
+        close();
+
+#if defined(YOURGAME_PLATFORM_DESKTOP)
+        std::string path = nativeFilePath(filename);
+        if (!path.empty())
+        {
+#if defined(_WIN32)
+            // others may still write, replace or delete the file
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+            {
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                void *view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if (view != nullptr)
+                {
+                    m_file = file;
+                    m_mapping = mapping;
+                    m_data = static_cast<uint8_t const *>(view);
+                    m_size = static_cast<std::size_t>(size.QuadPart);
+                    m_mapped = true;
+                    return true;
+                }
+                if (mapping != nullptr)
+                {
+                    CloseHandle(mapping);
+                }
+            }
+            CloseHandle(file);
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                return false;
+            }
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                void *view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED)
+                {
+                    ::close(fd); // the mapping stays valid
+                    m_data = static_cast<uint8_t const *>(view);
+                    m_size = static_cast<std::size_t>(st.st_size);
+                    m_mapped = true;
+                    return true;
+                }
+            }
+            ::close(fd);
+#endif
+        }
+#endif
+
+        // not mapped: read into memory
+        if (yg::file::readFile(filename, m_buffer) != 0)
+        {
+            m_buffer.clear();
+            return false;
+        }
+        m_data = m_buffer.empty() ? nullptr : &m_buffer[0];
+        m_size = m_buffer.size();
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (m_mapped)
+        {
+#if defined(YOURGAME_PLATFORM_DESKTOP)
+#if defined(_WIN32)
+            UnmapViewOfFile(m_data);
+            CloseHandle(m_mapping);
+            CloseHandle(m_file);
+            m_mapping = nullptr;
+            m_file = nullptr;
+#else
+            munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+#endif
+        }
+        m_buffer.clear();
+        m_data = nullptr;
+        m_size = 0;
+        m_mapped = false;
+    }
+}
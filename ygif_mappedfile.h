@@ -0,0 +1,48 @@
+#ifndef YGIF_MAPPEDFILE_H
+#define YGIF_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mygame
+{
+    // native path of a yg::file path ("a//...", "p//..." or "s//..."), empty
+    // if unknown (assets on android)
+    std::string nativeFilePath(std::string const &filename);
+
+    // read-only view of the content of a file (yg::file path, "a//...",
+    // "p//..." or "s//..."). on desktop, the file is memory-mapped, on other
+    // platforms (or if mapping fails), it is read into memory.
+    // a mapped file must not be truncated while open (access past its end
+    // faults): write files that may be mapped to a temporary file and
+    // rename it, or keep the mapping short.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(MappedFile const &) = delete;
+        MappedFile &operator=(MappedFile const &) = delete;
+        ~MappedFile() { close(); }
+
+        bool open(std::string const &filename);
+        void close();
+
+        uint8_t const *data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+        bool isMapped() const { return m_mapped; }
+
+    private:
+        uint8_t const *m_data = nullptr;
+        std::size_t m_size = 0;
+        bool m_mapped = false;
+        std::vector<uint8_t> m_buffer; // if not mapped
+#if defined(_WIN32)
+        void *m_file = nullptr;
+        void *m_mapping = nullptr;
+#endif
+    };
+}
+
+#endif
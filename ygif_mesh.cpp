@@ -0,0 +1,406 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include "ygif_mesh.h"
+
+namespace mygame
+{
+    static_assert(sizeof(MeshHeader) == 56, "MeshHeader layout");
+    static_assert(sizeof(MeshVertex) == 44, "MeshVertex layout");
+
+    namespace
+    {
+        // indices into the position/texcoord/normal lists of one face vertex
+        struct ObjIndex
+        {
+            int v;
+            int t;
+            int n;
+
+            bool operator==(ObjIndex const &o) const { return v == o.v && t == o.t && n == o.n; }
+        };
+
+        struct ObjIndexHash
+        {
+            std::size_t operator()(ObjIndex const &i) const
+            {
+                return (static_cast<std::size_t>(i.v) * 73856093u) ^
+                       (static_cast<std::size_t>(i.t) * 19349663u) ^
+                       (static_cast<std::size_t>(i.n) * 83492791u);
+            }
+        };
+
+        // resolves 1-based or negative (relative) obj index, -1 if out of range
+        int resolveIndex(long idx, std::size_t count)
+        {
+            long i = (idx < 0) ? static_cast<long>(count) + idx : idx - 1;
+            return (i >= 0 && i < static_cast<long>(count)) ? static_cast<int>(i) : -1;
+        }
+
+        // parses "v", "v/t", "v//n" or "v/t/n". returns false on syntax errors
+        bool parseObjIndex(char const *tok, std::size_t numV, std::size_t numT, std::size_t numN, ObjIndex &out)
+        {
+            char *end;
+            out.v = resolveIndex(std::strtol(tok, &end, 10), numV);
+            out.t = -1;
+            out.n = -1;
+            if (end == tok || out.v < 0)
+            {
+                return false;
+            }
+            if (*end == '/')
+            {
+                tok = end + 1;
+                if (*tok != '/')
+                {
+                    out.t = resolveIndex(std::strtol(tok, &end, 10), numT);
+                    if (end == tok || out.t < 0)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    end = const_cast<char *>(tok);
+                }
+                if (*end == '/')
+                {
+                    tok = end + 1;
+                    out.n = resolveIndex(std::strtol(tok, &end, 10), numN);
+                    if (end == tok || out.n < 0)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool fail(std::string *error, std::string const &msg)
+        {
+            if (error != nullptr)
+            {
+                *error = msg;
+            }
+            return false;
+        }
+    }
+
+    bool parseMesh(void const *data, std::size_t size, MeshView &view)
+    {
+        if (data == nullptr || size < sizeof(MeshHeader))
+        {
+            return false;
+        }
+
+        MeshHeader const *h = static_cast<MeshHeader const *>(data);
+        if (std::memcmp(h->magic, "YGMS", 4) != 0 ||
+            h->version != meshFormatVersion ||
+            h->primitive > MESH_LINES)
+        {
+            return false;
+        }
+
+        uint64_t expected = sizeof(MeshHeader) +
+                            static_cast<uint64_t>(h->vertexCount) * sizeof(MeshVertex) +
+                            static_cast<uint64_t>(h->indexCount) * sizeof(uint32_t);
+        if (expected != size)
+        {
+            return false;
+        }
+
+        uint8_t const *bytes = static_cast<uint8_t const *>(data);
+        view.header = h;
+        view.vertices = reinterpret_cast<MeshVertex const *>(bytes + sizeof(MeshHeader));
+        view.indices = reinterpret_cast<uint32_t const *>(bytes + sizeof(MeshHeader) + h->vertexCount * sizeof(MeshVertex));
+        return true;
+    }
+
+    bool convertObjToMesh(char const *src, std::size_t size, uint64_t sourceHash,
+                          std::vector<uint8_t> &mesh, std::string *error)
+    {
+        std::vector<float> positions; // x, y, z
+        std::vector<float> colors;    // r, g, b per position
+        std::vector<float> texcoords; // u, v
+        std::vector<float> normals;   // x, y, z
+
+        std::vector<MeshVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::unordered_map<ObjIndex, uint32_t, ObjIndexHash> vertexSlots;
+
+        bool hasFaces = false;
+        bool hasLines = false;
+        std::vector<ObjIndex> stmt;
+        std::string line;
+        std::size_t lineNo = 0;
+
+        auto addVertex = [&](ObjIndex const &i) {
+            auto it = vertexSlots.find(i);
+            if (it != vertexSlots.end())
+            {
+                return it->second;
+            }
+            MeshVertex v;
+            std::memcpy(v.position, &positions[i.v * 3], sizeof(v.position));
+            std::memcpy(v.color, &colors[i.v * 3], sizeof(v.color));
+            if (i.t >= 0)
+            {
+                std::memcpy(v.texcoords, &texcoords[i.t * 2], sizeof(v.texcoords));
+            }
+            else
+            {
+                v.texcoords[0] = v.texcoords[1] = 0.0f;
+            }
+            if (i.n >= 0)
+            {
+                std::memcpy(v.normal, &normals[i.n * 3], sizeof(v.normal));
+            }
+            else
+            {
+                v.normal[0] = v.normal[1] = v.normal[2] = 0.0f;
+            }
+            uint32_t slot = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(v);
+            vertexSlots.insert({i, slot});
+            return slot;
+        };
+
+        std::size_t pos = 0;
+        while (pos < size)
+        {
+            std::size_t eol = pos;
+            while (eol < size && src[eol] != '\n')
+            {
+                ++eol;
+            }
+            line.assign(src + pos, eol - pos);
+            pos = eol + 1;
+            ++lineNo;
+
+            char const *c = line.c_str();
+            while (*c == ' ' || *c == '\t')
+            {
+                ++c;
+            }
+
+            if (c[0] == 'v' && (c[1] == ' ' || c[1] == '\t'))
+            {
+                char *end = const_cast<char *>(c + 1);
+                float vals[6] = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+                int n = 0;
+                for (; n < 6; ++n)
+                {
+                    char const *start = end;
+                    vals[n] = std::strtof(start, &end);
+                    if (end == start)
+                    {
+                        break;
+                    }
+                }
+                if (n < 3)
+                {
+                    return fail(error, "line " + std::to_string(lineNo) + ": invalid vertex");
+                }
+                if (n < 6)
+                {
+                    vals[3] = vals[4] = vals[5] = 1.0f;
+                }
+                positions.insert(positions.end(), vals, vals + 3);
+                colors.insert(colors.end(), vals + 3, vals + 6);
+            }
+            else if ((c[0] == 'v' && c[1] == 't') || (c[0] == 'v' && c[1] == 'n'))
+            {
+                char *end = const_cast<char *>(c + 2);
+                int numVals = (c[1] == 't') ? 2 : 3;
+                float vals[3] = {0.0f, 0.0f, 0.0f};
+                for (int n = 0; n < numVals; ++n)
+                {
+                    vals[n] = std::strtof(end, &end);
+                }
+                std::vector<float> &dst = (c[1] == 't') ? texcoords : normals;
+                dst.insert(dst.end(), vals, vals + numVals);
+            }
+            else if ((c[0] == 'f' || c[0] == 'l') && (c[1] == ' ' || c[1] == '\t'))
+            {
+                bool isFace = (c[0] == 'f');
+                (isFace ? hasFaces : hasLines) = true;
+                if (hasFaces && hasLines)
+                {
+                    return fail(error, "faces and lines mixed");
+                }
+
+                stmt.clear();
+                char const *tok = c + 1;
+                while (*tok != '\0')
+                {
+                    while (*tok == ' ' || *tok == '\t' || *tok == '\r')
+                    {
+                        ++tok;
+                    }
+                    if (*tok == '\0')
+                    {
+                        break;
+                    }
+                    ObjIndex i;
+                    if (!parseObjIndex(tok, positions.size() / 3, texcoords.size() / 2, normals.size() / 3, i))
+                    {
+                        return fail(error, "line " + std::to_string(lineNo) + ": invalid index");
+                    }
+                    stmt.push_back(i);
+                    while (*tok != '\0' && *tok != ' ' && *tok != '\t' && *tok != '\r')
+                    {
+                        ++tok;
+                    }
+                }
+
+                if (isFace)
+                {
+                    if (stmt.size() < 3)
+                    {
+                        return fail(error, "line " + std::to_string(lineNo) + ": face with less than 3 vertices");
+                    }
+
+                    // face normal for vertices without normal
+                    if (stmt[0].n < 0 || stmt[1].n < 0 || stmt[2].n < 0)
+                    {
+                        float const *p0 = &positions[stmt[0].v * 3];
+                        float const *p1 = &positions[stmt[1].v * 3];
+                        float const *p2 = &positions[stmt[2].v * 3];
+                        float a[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                        float b[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                        float n[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+                        float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                        if (len > 0.0f)
+                        {
+                            n[0] /= len;
+                            n[1] /= len;
+                            n[2] /= len;
+                        }
+                        int faceNormal = static_cast<int>(normals.size() / 3);
+                        normals.insert(normals.end(), n, n + 3);
+                        for (auto &i : stmt)
+                        {
+                            if (i.n < 0)
+                            {
+                                i.n = faceNormal;
+                            }
+                        }
+                    }
+
+                    // triangle fan
+                    uint32_t first = addVertex(stmt[0]);
+                    uint32_t prev = addVertex(stmt[1]);
+                    for (std::size_t k = 2; k < stmt.size(); ++k)
+                    {
+                        uint32_t cur = addVertex(stmt[k]);
+                        indices.push_back(first);
+                        indices.push_back(prev);
+                        indices.push_back(cur);
+                        prev = cur;
+                    }
+                }
+                else
+                {
+                    // polyline: one segment per consecutive pair
+                    for (std::size_t k = 1; k < stmt.size(); ++k)
+                    {
+                        indices.push_back(addVertex(stmt[k - 1]));
+                        indices.push_back(addVertex(stmt[k]));
+                    }
+                }
+            }
+            else if (std::strncmp(c, "mtllib", 6) == 0 || std::strncmp(c, "usemtl", 6) == 0)
+            {
+                return fail(error, "materials are not supported");
+            }
+            // comments, groups, objects, smoothing groups: ignored
+        }
+
+        if (vertices.empty() || indices.empty())
+        {
+            return fail(error, "no faces or lines");
+        }
+
+        MeshHeader h;
+        std::memcpy(h.magic, "YGMS", 4);
+        h.version = meshFormatVersion;
+        h.primitive = hasLines ? MESH_LINES : MESH_TRIANGLES;
+        h.vertexCount = static_cast<uint32_t>(vertices.size());
+        h.indexCount = static_cast<uint32_t>(indices.size());
+        h.reserved = 0;
+        h.sourceHash = sourceHash;
+        for (int k = 0; k < 3; ++k)
+        {
+            h.boundsMin[k] = vertices[0].position[k];
+            h.boundsMax[k] = vertices[0].position[k];
+        }
+        for (auto const &v : vertices)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                h.boundsMin[k] = std::fmin(h.boundsMin[k], v.position[k]);
+                h.boundsMax[k] = std::fmax(h.boundsMax[k], v.position[k]);
+            }
+        }
+
+        std::size_t vertBytes = vertices.size() * sizeof(MeshVertex);
+        std::size_t idxBytes = indices.size() * sizeof(uint32_t);
+        mesh.resize(sizeof(MeshHeader) + vertBytes + idxBytes);
+        std::memcpy(&mesh[0], &h, sizeof(MeshHeader));
+        std::memcpy(&mesh[sizeof(MeshHeader)], &vertices[0], vertBytes);
+        std::memcpy(&mesh[sizeof(MeshHeader) + vertBytes], &indices[0], idxBytes);
+        return true;
+    }
+
+    bool computeObjBounds(char const *src, std::size_t size, float boundsMin[3], float boundsMax[3])
+    {
+        bool found = false;
+        std::string line;
+        std::size_t pos = 0;
+        while (pos < size)
+        {
+            std::size_t eol = pos;
+            while (eol < size && src[eol] != '\n')
+            {
+                ++eol;
+            }
+            line.assign(src + pos, eol - pos);
+            pos = eol + 1;
+
+            char const *c = line.c_str();
+            while (*c == ' ' || *c == '\t')
+            {
+                ++c;
+            }
+            if (c[0] != 'v' || (c[1] != ' ' && c[1] != '\t'))
+            {
+                continue;
+            }
+
+            char *end = const_cast<char *>(c + 1);
+            float p[3];
+            int n = 0;
+            for (; n < 3; ++n)
+            {
+                char const *start = end;
+                p[n] = std::strtof(start, &end);
+                if (end == start)
+                {
+                    break;
+                }
+            }
+            if (n < 3)
+            {
+                continue;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                boundsMin[k] = found ? std::fmin(boundsMin[k], p[k]) : p[k];
+                boundsMax[k] = found ? std::fmax(boundsMax[k], p[k]) : p[k];
+            }
+            found = true;
+        }
+        return found;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef YGIF_MESH_H
+#define YGIF_MESH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mygame
+{
+    // binary mesh format (.ygmesh), converted from .obj files:
+    //   MeshHeader
+    //   MeshVertex[vertexCount] (interleaved, layout of default.vert)
+    //   uint32_t[indexCount]
+    // little-endian, all sections 4 byte aligned. the file can be used in
+    // place (memory-mapped), vertices and indices are uploaded as they are.
+    struct MeshHeader
+    {
+        char magic[4];       // "YGMS"
+        uint32_t version;    // meshFormatVersion
+        uint32_t primitive;  // MeshPrimitive
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t reserved;
+        float boundsMin[3];
+        float boundsMax[3];
+        uint64_t sourceHash; // hashFnv1a64() of the .obj file
+    };
+
+    struct MeshVertex
+    {
+        float position[3];  // location 0
+        float normal[3];    // location 1
+        float texcoords[2]; // location 2
+        float color[3];     // location 3
+    };
+
+    enum MeshPrimitive : uint32_t
+    {
+        MESH_TRIANGLES = 0,
+        MESH_LINES = 1
+    };
+
+    uint32_t const meshFormatVersion = 1;
+
+    // a validated view into a binary mesh
+    struct MeshView
+    {
+        MeshHeader const *header = nullptr;
+        MeshVertex const *vertices = nullptr;
+        uint32_t const *indices = nullptr;
+    };
+
+    // returns false if data does not contain a complete mesh of this version.
+    // data has to be 4 byte aligned
+    bool parseMesh(void const *data, std::size_t size, MeshView &view);
+
+    // converts the .obj source (v, vt, vn, f and l statements, optional vertex
+    // colors "v x y z r g b") into a binary mesh. faces are triangulated,
+    // missing normals are replaced by face normals, missing colors are white.
+    // returns false if the source is not supported: files referencing
+    // materials, or mixing faces and lines, are left to yg::gl::loadGeometry()
+    bool convertObjToMesh(char const *src, std::size_t size, uint64_t sourceHash,
+                          std::vector<uint8_t> &mesh, std::string *error = nullptr);
+
+    // bounds of the vertex positions ("v" statements) of an .obj source.
+    // returns false if there are none
+    bool computeObjBounds(char const *src, std::size_t size, float boundsMin[3], float boundsMax[3]);
+}
+
+#endif
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include "yourgame/yourgame.h"
+#include "ygif_pagedfile.h"
+
+#if !defined(_WIN32)
+#include <sys/types.h>
+#endif
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        // 64 bit offsets
+        bool seekTo(std::FILE *f, std::size_t off, int origin = SEEK_SET)
+        {
+#if defined(_WIN32)
+            return _fseeki64(f, static_cast<__int64>(off), origin) == 0;
+#else
+            return fseeko(f, static_cast<off_t>(off), origin) == 0;
+#endif
+        }
+
+        std::size_t tellPos(std::FILE *f)
+        {
+#if defined(_WIN32)
+            __int64 pos = _ftelli64(f);
+#else
+            off_t pos = ftello(f);
+#endif
+            return (pos > 0) ? static_cast<std::size_t>(pos) : 0;
+        }
+    }
+
+    std::size_t const PagedFile::pageSize;
+    std::size_t const PagedFile::maxCachedPages;
+
+    bool PagedFile::open(std::string const &filename)
+    {
+        close();
+        m_filename = filename;
+        m_path = nativeFilePath(filename);
+        return openData();
+    }
+
+    void PagedFile::close()
+    {
+        closeData();
+        m_dirty.clear();
+    }
+
+    uint8_t PagedFile::read(std::size_t off)
+    {
+        std::size_t page = off / pageSize;
+        if (page != m_lastPage)
+        {
+            auto dirty = m_dirty.find(page);
+            m_lastData = (dirty != m_dirty.end()) ? dirty->second.data() : cleanPage(page);
+            m_lastPage = page;
+        }
+        return m_lastData[off % pageSize];
+    }
+
+    void PagedFile::write(std::size_t off, uint8_t value)
+    {
+        if (off >= m_size || read(off) == value)
+        {
+            return;
+        }
+
+        // copy on first write
+        std::size_t page = off / pageSize;
+        auto dirty = m_dirty.find(page);
+        if (dirty == m_dirty.end())
+        {
+            uint8_t const *src = cleanPage(page);
+            std::size_t n = std::min(pageSize, m_size - page * pageSize);
+            dirty = m_dirty.insert({page, std::vector<uint8_t>(src, src + n)}).first;
+            m_lastPage = SIZE_MAX;
+        }
+        dirty->second[off % pageSize] = value;
+    }
+
+    bool PagedFile::save()
+    {
+        if (m_dirty.empty())
+        {
+            return true;
+        }
+
+        bool ok = true;
+        if (m_path.empty())
+        {
+            // no native path: the whole file, via yg::file
+            std::vector<uint8_t> content(m_mapped.data(), m_mapped.data() + m_size);
+            for (auto const &d : m_dirty)
+            {
+                std::copy(d.second.begin(), d.second.end(), content.begin() + d.first * pageSize);
+            }
+            ok = (yg::file::writeFile(m_filename, content.data(), content.size()) == 0);
+        }
+        else
+        {
+            // the mapping is released while writing (windows: sharing)
+            closeData();
+            std::FILE *f = std::fopen(m_path.c_str(), "r+b");
+            ok = (f != nullptr);
+            for (auto d = m_dirty.begin(); ok && d != m_dirty.end();)
+            {
+                // one range of contiguous pages
+                std::size_t next = d->first;
+                ok = seekTo(f, next * pageSize);
+                for (; ok && d != m_dirty.end() && d->first == next; ++d, ++next)
+                {
+                    ok = (std::fwrite(d->second.data(), 1, d->second.size(), f) == d->second.size());
+                }
+            }
+            if (f != nullptr)
+            {
+                ok = (std::fclose(f) == 0) && ok;
+            }
+        }
+
+        if (ok)
+        {
+            m_dirty.clear();
+        }
+        if (m_mode == Mode::CLOSED || ok)
+        {
+            closeData();
+            ok = openData() && ok;
+        }
+        if (!ok)
+        {
+            yg::log::error("PagedFile::save(): failed to write %v", m_filename);
+        }
+        return ok;
+    }
+
+    uint8_t const *PagedFile::cleanPage(std::size_t page)
+    {
+        if (m_mode != Mode::PAGED)
+        {
+            return m_mapped.data() + page * pageSize;
+        }
+
+        auto it = m_pages.find(page);
+        if (it != m_pages.end())
+        {
+            return it->second.data();
+        }
+
+        if (m_pages.size() >= maxCachedPages)
+        {
+            m_pages.clear();
+            m_lastPage = SIZE_MAX;
+        }
+        std::vector<uint8_t> &data = m_pages[page];
+        data.assign(std::min(pageSize, m_size - page * pageSize), 0u);
+        if (seekTo(m_file, page * pageSize))
+        {
+            std::fread(data.data(), 1, data.size(), m_file); // zeros if short
+        }
+        return data.data();
+    }
+
+    bool PagedFile::openData()
+    {
+#if defined(YOURGAME_PLATFORM_DESKTOP)
+        // only assets are mapped: project and savefiles are rewritten by
+        // other code (editors, caches), a mapping would fault on access past
+        // a truncation. pages read from a shrunk file are zero-filled
+        if (m_filename.compare(0, 3, "a//") == 0 && m_mapped.open(m_filename) && m_mapped.isMapped())
+        {
+            m_mode = Mode::MAPPED;
+            m_size = m_mapped.size();
+            return true;
+        }
+        m_mapped.close();
+#endif
+
+        if (!m_path.empty())
+        {
+            m_file = std::fopen(m_path.c_str(), "rb");
+            if (m_file != nullptr && seekTo(m_file, 0, SEEK_END))
+            {
+                m_mode = Mode::PAGED;
+                m_size = tellPos(m_file);
+                return true;
+            }
+            closeData();
+        }
+
+        if (m_mapped.open(m_filename))
+        {
+            m_mode = Mode::IN_MEMORY;
+            m_size = m_mapped.size();
+            return true;
+        }
+        return false;
+    }
+
+    void PagedFile::closeData()
+    {
+        m_mapped.close();
+        if (m_file != nullptr)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        m_pages.clear();
+        m_lastPage = SIZE_MAX;
+        m_lastData = nullptr;
+        m_mode = Mode::CLOSED;
+        m_size = 0;
+    }
+}
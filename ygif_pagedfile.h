@@ -0,0 +1,79 @@
+#ifndef YGIF_PAGEDFILE_H
+#define YGIF_PAGEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ygif_mappedfile.h"
+
+namespace mygame
+{
+    // byte access to a file of any size, with a copy-on-write overlay for
+    // edits (Hex Editor). the file is memory-mapped (assets on desktop), or
+    // read page by page on access via its native path (project and
+    // savefiles, which may be rewritten while open), or read entirely (no
+    // native path: assets on android). written bytes go to copies of their pages,
+    // save() writes back the modified pages only.
+    class PagedFile
+    {
+    public:
+        static std::size_t const pageSize = 4096;
+        static std::size_t const maxCachedPages = 256; // paged reads
+
+        enum class Mode
+        {
+            CLOSED,
+            MAPPED,
+            PAGED,
+            IN_MEMORY
+        };
+
+        PagedFile() = default;
+        PagedFile(PagedFile const &) = delete;
+        PagedFile &operator=(PagedFile const &) = delete;
+        ~PagedFile() { close(); }
+
+        bool open(std::string const &filename);
+        void close();
+
+        std::size_t size() const { return m_size; }
+        Mode mode() const { return m_mode; }
+
+        // off < size()
+        uint8_t read(std::size_t off);
+        void write(std::size_t off, uint8_t value);
+
+        std::size_t numDirtyPages() const { return m_dirty.size(); }
+
+        // writes the dirty pages (contiguous ones as one range) to the file,
+        // and drops them. in memory without native path: writes the whole
+        // file via yg::file. the edits are kept if writing fails
+        bool save();
+
+    private:
+        uint8_t const *cleanPage(std::size_t page);
+        bool openData();
+        void closeData();
+
+        std::string m_filename;
+        std::string m_path; // native
+        Mode m_mode = Mode::CLOSED;
+        std::size_t m_size = 0;
+
+        MappedFile m_mapped; // MAPPED, IN_MEMORY
+        std::FILE *m_file = nullptr; // PAGED
+        std::unordered_map<std::size_t, std::vector<uint8_t>> m_pages; // PAGED: clean pages read
+
+        std::map<std::size_t, std::vector<uint8_t>> m_dirty; // page -> modified copy
+
+        // last page accessed by read()
+        std::size_t m_lastPage = SIZE_MAX;
+        uint8_t const *m_lastData = nullptr;
+    };
+}
+
+#endif
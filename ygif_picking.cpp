@@ -0,0 +1,527 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ygif_picking.h"
+#include "ygif_host.h"
+#include "ygif_vecmath.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        int const maxLeafSize = 4;
+        float const noHit = std::numeric_limits<float>::max();
+
+        // entry distance of the ray into box b (slab test), noHit if missed
+        // or farther than maxDist. invDir: 1 / dir per component
+        float rayBox(Bounds const &b, glm::vec3 const &org, glm::vec3 const &invDir, float maxDist)
+        {
+            float tmin = 0.0f;
+            float tmax = maxDist;
+            for (int i = 0; i < 3; ++i)
+            {
+                float t0 = (b.min[i] - org[i]) * invDir[i];
+                float t1 = (b.max[i] - org[i]) * invDir[i];
+                tmin = std::max(tmin, std::min(t0, t1));
+                tmax = std::min(tmax, std::max(t0, t1));
+            }
+            return (tmin <= tmax) ? tmin : noHit;
+        }
+
+        glm::vec3 inverse(glm::vec3 const &dir)
+        {
+            return glm::vec3(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+        }
+
+        Bounds merge(Bounds const &a, Bounds const &b)
+        {
+            return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+
+        bool sameBounds(Bounds const &a, Bounds const &b)
+        {
+            return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+                   a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+        }
+
+        yg::math::Trafo *toTrafo(lua_State *L, int idx)
+        {
+            return lua_isnoneornil(L, idx) ? nullptr : luabridge::Stack<yg::math::Trafo *>::get(L, idx);
+        }
+
+        void pushHit(lua_State *L, int id, float distance)
+        {
+            if (id > 0)
+            {
+                lua_pushinteger(L, id);
+                lua_pushnumber(L, distance);
+            }
+            else
+            {
+                lua_pushnil(L);
+                lua_pushnil(L);
+            }
+        }
+    }
+
+    PickScene::~PickScene()
+    {
+        if (m_L != nullptr)
+        {
+            for (auto const &a : m_anchors)
+            {
+                luaL_unref(m_L, LUA_REGISTRYINDEX, a.second.first);
+            }
+        }
+    }
+
+    int PickScene::addBox(lua_State *L)
+    {
+        Object o = Object();
+        o.trafo = toTrafo(L, 2);
+        o.local.min = readVec3(L, 3);
+        o.local.max = readVec3(L, 4);
+        return addObject(L, o, 2);
+    }
+
+    int PickScene::addSphere(lua_State *L)
+    {
+        Object o = Object();
+        o.sphere = true;
+        o.trafo = toTrafo(L, 2);
+        o.radius = static_cast<float>(luaL_checknumber(L, 3));
+        return addObject(L, o, 2);
+    }
+
+    int PickScene::addGeometry(lua_State *L)
+    {
+        Object o = Object();
+        o.trafo = toTrafo(L, 2);
+        yg::gl::Geometry *geo = luabridge::Stack<yg::gl::Geometry *>::get(L, 3);
+        Bounds const *b = (geo != nullptr) ? getGeometryBounds(geo) : nullptr;
+        if (b == nullptr)
+        {
+            return luaL_error(L, "addGeometry(): geometry without bounds");
+        }
+        o.local = *b;
+        return addObject(L, o, 2);
+    }
+
+    int PickScene::addPool(lua_State *L)
+    {
+        TrafoPool *pool = luabridge::Stack<TrafoPool *>::get(L, 2);
+        luaL_argcheck(L, pool != nullptr, 2, "TrafoPool expected");
+        Object o = Object();
+        o.pool = pool;
+        o.local.min = readVec3(L, 3);
+        o.local.max = readVec3(L, 4);
+
+        // consecutive ids: new slots at the end
+        int firstId = static_cast<int>(m_objects.size()) + 1;
+        std::vector<int> freeSlots;
+        freeSlots.swap(m_freeSlots);
+        for (int i = 0; i < pool->size(); ++i)
+        {
+            o.poolIndex = i;
+            addObject(L, o, 2);
+            lua_pop(L, 1); // id
+        }
+        m_freeSlots.swap(freeSlots);
+        lua_pushinteger(L, firstId);
+        return 1;
+    }
+
+    int PickScene::remove(lua_State *L)
+    {
+        lua_Integer id = luaL_checkinteger(L, 2);
+        bool removed = false;
+        if (id >= 1 && id <= static_cast<lua_Integer>(m_objects.size()) && m_objects[id - 1].active)
+        {
+            Object &o = m_objects[id - 1];
+            unanchor((o.trafo != nullptr) ? static_cast<void const *>(o.trafo) : static_cast<void const *>(o.pool));
+            o.active = false;
+            m_freeSlots.push_back(static_cast<int>(id - 1));
+            --m_numActive;
+            m_needsBuild = true;
+            removed = true;
+        }
+        lua_pushboolean(L, removed);
+        return 1;
+    }
+
+    int PickScene::pick(lua_State *L)
+    {
+        yg::math::Camera *camera = luabridge::Stack<yg::math::Camera *>::get(L, 2);
+        luaL_argcheck(L, camera != nullptr, 2, "Camera expected");
+        glm::vec3 org, dir;
+        camera->castRay(static_cast<float>(luaL_checknumber(L, 3)),
+                        static_cast<float>(luaL_checknumber(L, 4)),
+                        org, dir);
+        float distance;
+        int id = nearestHit(org, glm::normalize(dir), distance);
+        pushHit(L, id, distance);
+        return 2;
+    }
+
+    int PickScene::raycast(lua_State *L)
+    {
+        glm::vec3 org = readVec3(L, 2);
+        glm::vec3 dir = glm::normalize(readVec3(L, 3));
+        float distance;
+        int id = nearestHit(org, dir, distance);
+        pushHit(L, id, distance);
+        return 2;
+    }
+
+    int PickScene::raycastBatch(lua_State *L)
+    {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        if (lua_istable(L, 3))
+        {
+            lua_settop(L, 3);
+        }
+        else
+        {
+            lua_settop(L, 2);
+            lua_newtable(L);
+        }
+
+        int numRays = static_cast<int>(lua_rawlen(L, 2) / 6);
+        float r[6];
+        for (int i = 0; i < numRays; ++i)
+        {
+            for (int k = 0; k < 6; ++k)
+            {
+                lua_rawgeti(L, 2, i * 6 + k + 1);
+                r[k] = static_cast<float>(lua_tonumber(L, -1));
+                lua_pop(L, 1);
+            }
+            float distance = 0.0f;
+            int id = nearestHit(glm::vec3(r[0], r[1], r[2]), glm::normalize(glm::vec3(r[3], r[4], r[5])), distance);
+            lua_pushinteger(L, id);
+            lua_rawseti(L, 3, i * 2 + 1);
+            lua_pushnumber(L, (id > 0) ? distance : 0.0f);
+            lua_rawseti(L, 3, i * 2 + 2);
+        }
+        return 1;
+    }
+
+    void PickScene::update()
+    {
+        if (m_needsBuild)
+        {
+            build();
+            return;
+        }
+
+        // mark the leaves of objects that moved
+        bool changed = false;
+        for (std::size_t s = 0; s < m_objects.size(); ++s)
+        {
+            Object &o = m_objects[s];
+            if (!o.active)
+            {
+                continue;
+            }
+            Bounds wb = worldBounds(o);
+            if (!sameBounds(wb, o.world))
+            {
+                o.world = wb;
+                m_dirty[m_leafOf[s]] = true;
+                changed = true;
+            }
+        }
+        if (!changed)
+        {
+            return;
+        }
+
+        // refit bottom-up: children are stored after their parents
+        for (int n = static_cast<int>(m_nodes.size()) - 1; n >= 0; --n)
+        {
+            if (!m_dirty[n])
+            {
+                continue;
+            }
+            m_dirty[n] = false;
+            Node &node = m_nodes[n];
+            if (node.left < 0)
+            {
+                node.box = m_objects[m_order[node.first]].world;
+                for (int i = 1; i < node.count; ++i)
+                {
+                    node.box = merge(node.box, m_objects[m_order[node.first + i]].world);
+                }
+            }
+            else
+            {
+                node.box = merge(m_nodes[node.left].box, m_nodes[node.right].box);
+            }
+            if (node.parent >= 0)
+            {
+                m_dirty[node.parent] = true;
+            }
+        }
+    }
+
+    int PickScene::size() const
+    {
+        return m_numActive;
+    }
+
+    int PickScene::nearestHit(glm::vec3 const &org, glm::vec3 const &dir, float &distance)
+    {
+        refitIfNewFrame();
+        distance = noHit;
+        if (m_nodes.empty())
+        {
+            return 0;
+        }
+
+        glm::vec3 invDir = inverse(dir);
+        int best = -1;
+        int stack[64];
+        int stackSize = 0;
+        if (rayBox(m_nodes[0].box, org, invDir, distance) != noHit)
+        {
+            stack[stackSize++] = 0;
+        }
+        while (stackSize > 0)
+        {
+            Node const &node = m_nodes[stack[--stackSize]];
+            if (node.left < 0)
+            {
+                for (int i = 0; i < node.count; ++i)
+                {
+                    int slot = m_order[node.first + i];
+                    float d;
+                    if (hitObject(m_objects[slot], org, dir, distance, d))
+                    {
+                        distance = d;
+                        best = slot;
+                    }
+                }
+                continue;
+            }
+
+            // nearer child on top of the stack
+            float dl = rayBox(m_nodes[node.left].box, org, invDir, distance);
+            float dr = rayBox(m_nodes[node.right].box, org, invDir, distance);
+            int near = (dl <= dr) ? node.left : node.right;
+            int far = (dl <= dr) ? node.right : node.left;
+            if (std::max(dl, dr) != noHit && stackSize < 64)
+            {
+                stack[stackSize++] = far;
+            }
+            if (std::min(dl, dr) != noHit && stackSize < 64)
+            {
+                stack[stackSize++] = near;
+            }
+        }
+        return best + 1;
+    }
+
+    int PickScene::addObject(lua_State *L, Object const &o, int anchorIdx)
+    {
+        if (m_L == nullptr)
+        {
+            m_L = luaMainThread(L);
+        }
+        if (o.trafo != nullptr || o.pool != nullptr)
+        {
+            anchor(L, anchorIdx, (o.trafo != nullptr) ? static_cast<void const *>(o.trafo) : static_cast<void const *>(o.pool));
+        }
+
+        int slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<int>(m_objects.size());
+            m_objects.push_back(Object());
+        }
+        m_objects[slot] = o;
+        m_objects[slot].active = true;
+        ++m_numActive;
+        m_needsBuild = true;
+
+        lua_pushinteger(L, slot + 1);
+        return 1;
+    }
+
+    void PickScene::anchor(lua_State *L, int idx, void const *ptr)
+    {
+        auto it = m_anchors.find(ptr);
+        if (it != m_anchors.end())
+        {
+            ++(it->second.second);
+            return;
+        }
+        lua_pushvalue(L, idx);
+        m_anchors[ptr] = {luaL_ref(L, LUA_REGISTRYINDEX), 1};
+    }
+
+    void PickScene::unanchor(void const *ptr)
+    {
+        auto it = m_anchors.find(ptr);
+        if (it != m_anchors.end() && --(it->second.second) <= 0)
+        {
+            luaL_unref(m_L, LUA_REGISTRYINDEX, it->second.first);
+            m_anchors.erase(it);
+        }
+    }
+
+    glm::mat4 PickScene::worldMat(Object const &o) const
+    {
+        if (o.trafo != nullptr)
+        {
+            return o.trafo->mat();
+        }
+        if (o.pool != nullptr && o.poolIndex < o.pool->size())
+        {
+            return o.pool->matrices()[o.poolIndex];
+        }
+        return glm::mat4(1.0f);
+    }
+
+    Bounds PickScene::worldBounds(Object const &o) const
+    {
+        glm::mat4 m = worldMat(o);
+        if (!o.sphere)
+        {
+            return transformBounds(o.local, m);
+        }
+        glm::vec3 c = glm::vec3(m[3]);
+        float r = o.radius * std::max(glm::length(glm::vec3(m[0])),
+                                      std::max(glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2]))));
+        return {c - glm::vec3(r), c + glm::vec3(r)};
+    }
+
+    bool PickScene::hitObject(Object const &o, glm::vec3 const &org, glm::vec3 const &dir, float maxDist, float &distance) const
+    {
+        if (rayBox(o.world, org, inverse(dir), maxDist) == noHit)
+        {
+            return false;
+        }
+
+        if (o.sphere)
+        {
+            // the world box of a sphere is centered, half its size is the radius
+            glm::vec3 c = (o.world.min + o.world.max) * 0.5f;
+            float r = (o.world.max.x - o.world.min.x) * 0.5f;
+            glm::vec3 oc = org - c;
+            float b = glm::dot(oc, dir);
+            float disc = b * b - (glm::dot(oc, oc) - r * r);
+            if (disc < 0.0f)
+            {
+                return false;
+            }
+            float t = -b - std::sqrt(disc);
+            t = (t < 0.0f) ? (-b + std::sqrt(disc)) : t; // origin inside
+            distance = t;
+            return t >= 0.0f && t < maxDist;
+        }
+
+        // oriented box: the ray in model space, t is the same in both spaces
+        glm::mat4 inv = glm::inverse(worldMat(o));
+        glm::vec3 lorg = glm::vec3(inv * glm::vec4(org, 1.0f));
+        glm::vec3 ldir = glm::vec3(inv * glm::vec4(dir, 0.0f));
+        distance = rayBox(o.local, lorg, inverse(ldir), maxDist);
+        return distance != noHit;
+    }
+
+    void PickScene::build()
+    {
+        m_needsBuild = false;
+        m_nodes.clear();
+        m_order.clear();
+        m_leafOf.assign(m_objects.size(), -1);
+        for (std::size_t s = 0; s < m_objects.size(); ++s)
+        {
+            if (m_objects[s].active)
+            {
+                m_objects[s].world = worldBounds(m_objects[s]);
+                m_order.push_back(static_cast<int>(s));
+            }
+        }
+        if (!m_order.empty())
+        {
+            m_nodes.reserve(2 * m_order.size() / maxLeafSize + 1);
+            buildNode(0, static_cast<int>(m_order.size()), -1);
+        }
+        m_dirty.assign(m_nodes.size(), false);
+    }
+
+    // top-down, median split along the largest extent of the centers
+    int PickScene::buildNode(int first, int count, int parent)
+    {
+        int n = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+        Bounds box = m_objects[m_order[first]].world;
+        Bounds centers = {(box.min + box.max) * 0.5f, (box.min + box.max) * 0.5f};
+        for (int i = 1; i < count; ++i)
+        {
+            Bounds const &b = m_objects[m_order[first + i]].world;
+            box = merge(box, b);
+            glm::vec3 c = (b.min + b.max) * 0.5f;
+            centers = merge(centers, {c, c});
+        }
+        m_nodes[n].box = box;
+        m_nodes[n].parent = parent;
+
+        if (count <= maxLeafSize)
+        {
+            m_nodes[n].left = -1;
+            m_nodes[n].right = -1;
+            m_nodes[n].first = first;
+            m_nodes[n].count = count;
+            for (int i = 0; i < count; ++i)
+            {
+                m_leafOf[m_order[first + i]] = n;
+            }
+            return n;
+        }
+
+        glm::vec3 ext = centers.max - centers.min;
+        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : ((ext.y > ext.z) ? 1 : 2);
+        int half = count / 2;
+        std::nth_element(m_order.begin() + first, m_order.begin() + first + half, m_order.begin() + first + count,
+                         [this, axis](int a, int b)
+                         {
+                             Bounds const &ba = m_objects[a].world;
+                             Bounds const &bb = m_objects[b].world;
+                             return (ba.min[axis] + ba.max[axis]) < (bb.min[axis] + bb.max[axis]);
+                         });
+
+        m_nodes[n].first = first;
+        m_nodes[n].count = 0;
+        int left = buildNode(first, half, n);
+        int right = buildNode(first + half, count - half, n);
+        m_nodes[n].left = left;
+        m_nodes[n].right = right;
+        return n;
+    }
+
+    void PickScene::refitIfNewFrame()
+    {
+        double now = host::timeGetTime();
+        if (m_needsBuild || now != m_lastRefitTime)
+        {
+            m_lastRefitTime = now;
+            update();
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef YGIF_PICKING_H
+#define YGIF_PICKING_H
+
+#include <unordered_map>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_culling.h"
+#include "ygif_trafopool.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // ray casting against many objects (yg.math.PickScene): boxes and spheres
+    // in model space, linked to a Trafo or an element of a TrafoPool, in a
+    // bounding volume hierarchy. the hierarchy is rebuilt after objects were
+    // added or removed, and refitted for changed transformations once per
+    // frame (first query of a frame) or by update(). boxes are hit exactly
+    // (oriented by the transformation), spheres scale with the largest axis.
+    // registered Trafos and TrafoPools are kept alive by the scene. a Trafo
+    // owned by another object (cam:trafo()) only holds a pointer into it: the
+    // owner is not kept alive, the script has to, or remove() the object first.
+    // object ids are > 0, 0 is returned for no hit.
+    class PickScene
+    {
+    public:
+        PickScene() = default;
+        PickScene(PickScene const &) = delete;
+        PickScene &operator=(PickScene const &) = delete;
+        ~PickScene();
+
+        // lua_CFunction members. trafo may be nil (identity)
+        int addBox(lua_State *L);      // scene:addBox(trafo, min, max) -> id
+        int addSphere(lua_State *L);   // scene:addSphere(trafo, radius) -> id
+        int addGeometry(lua_State *L); // scene:addGeometry(trafo, geo) -> id, box from the geometry bounds
+        int addPool(lua_State *L);     // scene:addPool(pool, min, max) -> id of element 1, consecutive ids
+        int remove(lua_State *L);      // scene:remove(id) -> true if removed
+        int pick(lua_State *L);        // scene:pick(camera, viewportX, viewportY) -> id, distance
+        int raycast(lua_State *L);     // scene:raycast(org, dir) -> id, distance
+
+        // scene:raycastBatch(rays [, hits]) -> hits. rays: flat array
+        // {ox, oy, oz, dx, dy, dz, ...}, hits: flat array {id, distance, ...}
+        int raycastBatch(lua_State *L);
+
+        // refits the hierarchy to the current transformations
+        void update();
+
+        int size() const;
+
+        // nearest object hit by the ray org + t * dir (dir normalized), 0 if none
+        int nearestHit(glm::vec3 const &org, glm::vec3 const &dir, float &distance);
+
+    private:
+        struct Object
+        {
+            bool active;
+            bool sphere;
+            yourgame::math::Trafo *trafo; // or pool, or none
+            TrafoPool *pool;
+            int poolIndex;
+            Bounds local; // box
+            float radius; // sphere
+            Bounds world;
+        };
+
+        struct Node
+        {
+            Bounds box;
+            int left; // children, or -1 for leaves
+            int right;
+            int first; // leaves: range in m_order
+            int count;
+            int parent;
+        };
+
+        int addObject(lua_State *L, Object const &o, int anchorIdx);
+        void anchor(lua_State *L, int idx, void const *ptr);
+        void unanchor(void const *ptr);
+
+        glm::mat4 worldMat(Object const &o) const;
+        Bounds worldBounds(Object const &o) const;
+        bool hitObject(Object const &o, glm::vec3 const &org, glm::vec3 const &dir, float maxDist, float &distance) const;
+
+        void build();
+        int buildNode(int first, int count, int parent);
+        void refitIfNewFrame();
+
+        std::vector<Object> m_objects; // id - 1
+        std::vector<int> m_freeSlots;
+        int m_numActive = 0;
+
+        std::vector<Node> m_nodes; // parents before children
+        std::vector<int> m_order;  // object slots, grouped by leaf
+        std::vector<int> m_leafOf; // object slot -> leaf node
+        std::vector<bool> m_dirty;
+        bool m_needsBuild = true;
+        double m_lastRefitTime = -1.0;
+
+        // registry refs keeping the linked Trafos/TrafoPools alive: ref, count
+        std::unordered_map<void const *, std::pair<int, int>> m_anchors;
+        lua_State *m_L = nullptr; // main thread
+    };
+}
+
+#endif
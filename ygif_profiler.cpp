@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "yourgame/yourgame.h"
+#include "ygif_profiler.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    Profiler g_profiler;
+
+    namespace
+    {
+        std::size_t const maxCapturedEvents = 1000000;
+
+        // upvalues: original function, binding slot
+        int profiledBinding(lua_State *L)
+        {
+            double t0 = g_profiler.now();
+            lua_pushvalue(L, lua_upvalueindex(1));
+            lua_insert(L, 1);
+            lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+            g_profiler.addBindingCall(static_cast<int>(lua_tointeger(L, lua_upvalueindex(2))), t0, g_profiler.now());
+            return lua_gettop(L);
+        }
+
+        // json string literal content
+        std::string jsonEscape(std::string const &s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out.push_back('\\');
+                }
+                out.push_back((static_cast<unsigned char>(c) < 0x20) ? ' ' : c);
+            }
+            return out;
+        }
+    }
+
+    void Profiler::beginFrame(double frameDelta, lua_State *L)
+    {
+        if (m_history[0].empty())
+        {
+            for (auto &h : m_history)
+            {
+                h.assign(historySize, 0.0f);
+            }
+            m_luaMemKiB.assign(historySize, 0.0f);
+        }
+
+        // close the previous frame
+        double tickLua = std::max(0.0, m_sectionTime[SECTION_TICK_LUA] - m_sectionTime[SECTION_DRAW]);
+        double measured = m_sectionTime[SECTION_TICK_LUA] + m_sectionTime[SECTION_RENDER_IMGUI];
+        m_history[SECTION_TICK_LUA][m_historyPos] = static_cast<float>(tickLua * 1000.0);
+        m_history[SECTION_DRAW][m_historyPos] = static_cast<float>(m_sectionTime[SECTION_DRAW] * 1000.0);
+        m_history[SECTION_RENDER_IMGUI][m_historyPos] = static_cast<float>(m_sectionTime[SECTION_RENDER_IMGUI] * 1000.0);
+        m_history[SECTION_OTHER][m_historyPos] = static_cast<float>(std::max(0.0, frameDelta - measured) * 1000.0);
+        m_luaMemKiB[m_historyPos] = (L != nullptr) ? static_cast<float>(lua_gc(L, LUA_GCCOUNT, 0)) : 0.0f;
+        m_historyPos = (m_historyPos + 1) % historySize;
+        m_drawnLastFrame = m_drawn;
+        m_culledLastFrame = m_culled;
+        m_drawn = 0;
+        m_culled = 0;
+
+        for (auto &t : m_sectionTime)
+        {
+            t = 0.0;
+        }
+    }
+
+    void Profiler::beginSection(Section s)
+    {
+        m_sectionStart[s] = now();
+    }
+
+    void Profiler::endSection(Section s)
+    {
+        double t1 = now();
+        m_sectionTime[s] += t1 - m_sectionStart[s];
+        if (m_capturing && m_events.size() < maxCapturedEvents)
+        {
+            m_events.push_back({static_cast<int>(s), m_sectionStart[s], t1});
+        }
+    }
+
+    void Profiler::wrapBindings(lua_State *L)
+    {
+        std::unordered_set<void const *> visited;
+        lua_getglobal(L, "yg");
+        if (lua_istable(L, -1))
+        {
+            wrapTable(L, lua_gettop(L), "yg.", visited);
+        }
+        lua_pop(L, 1);
+    }
+
+    // namespaces contain functions, namespaces and class static tables.
+    // LuaBridge keeps the methods of a class in metatable(static).__class
+    // and __class.__const
+    void Profiler::wrapTable(lua_State *L, int tbl, std::string const &prefix, std::unordered_set<void const *> &visited)
+    {
+        if (!visited.insert(lua_topointer(L, tbl)).second)
+        {
+            return;
+        }
+
+        // collect the keys first, no new keys are added during lua_next()
+        std::vector<std::string> funcKeys;
+        std::vector<std::string> tableKeys;
+        lua_pushnil(L);
+        while (lua_next(L, tbl) != 0)
+        {
+            if (lua_type(L, -2) == LUA_TSTRING && std::strncmp(lua_tostring(L, -2), "__", 2) != 0)
+            {
+                if (lua_type(L, -1) == LUA_TFUNCTION)
+                {
+                    funcKeys.push_back(lua_tostring(L, -2));
+                }
+                else if (lua_istable(L, -1))
+                {
+                    tableKeys.push_back(lua_tostring(L, -2));
+                }
+            }
+            lua_pop(L, 1);
+        }
+
+        for (auto const &key : funcKeys)
+        {
+            lua_pushstring(L, key.c_str());
+            lua_pushstring(L, key.c_str());
+            lua_rawget(L, tbl);
+            std::string name = prefix + key;
+            auto slot = m_bindingSlots.find(name);
+            if (slot == m_bindingSlots.end())
+            {
+                slot = m_bindingSlots.insert({name, static_cast<int>(m_bindings.size())}).first;
+                m_bindings.push_back(BindingStats());
+                m_bindings.back().name = name;
+            }
+            lua_pushinteger(L, slot->second);
+            lua_pushcclosure(L, profiledBinding, 2);
+            lua_rawset(L, tbl);
+        }
+
+        for (auto const &key : tableKeys)
+        {
+            // the wait functions yield, which the wrapper does not support.
+            // yg.ffi is called from compiled LuaJIT traces, a wrapper (a C
+            // function) would stop their compilation
+            if (prefix + key == "yg.task" || prefix + key == "yg.ffi")
+            {
+                continue;
+            }
+
+            lua_pushstring(L, key.c_str());
+            lua_rawget(L, tbl);
+            int sub = lua_gettop(L);
+            wrapTable(L, sub, prefix + key + ".", visited);
+
+            if (lua_getmetatable(L, sub))
+            {
+                lua_pushstring(L, "__class");
+                lua_rawget(L, -2);
+                if (lua_istable(L, -1))
+                {
+                    wrapTable(L, lua_gettop(L), prefix + key + ":", visited);
+                    lua_pushstring(L, "__const");
+                    lua_rawget(L, -2);
+                    if (lua_istable(L, -1))
+                    {
+                        wrapTable(L, lua_gettop(L), prefix + key + ":", visited);
+                    }
+                    lua_pop(L, 1); // __const
+                }
+                lua_pop(L, 2); // __class, metatable
+            }
+            lua_pop(L, 1); // sub
+        }
+    }
+
+    void Profiler::resetStats()
+    {
+        for (auto &b : m_bindings)
+        {
+            b.calls = 0;
+            b.seconds = 0.0;
+        }
+        m_luaSamples.clear();
+        m_numLuaSamples = 0;
+    }
+
+    std::vector<float> Profiler::unrollHistory(std::vector<float> const &ring) const
+    {
+        std::vector<float> h;
+        if (!ring.empty())
+        {
+            h.insert(h.end(), ring.begin() + m_historyPos, ring.end());
+            h.insert(h.end(), ring.begin(), ring.begin() + m_historyPos);
+        }
+        return h;
+    }
+
+    char const *Profiler::sectionName(Section s)
+    {
+        static char const *const names[NUM_SECTIONS] = {"tickLua", "draw", "renderImgui", "other"};
+        return names[s];
+    }
+
+    void Profiler::startCapture()
+    {
+        m_events.clear();
+        m_capturing = true;
+    }
+
+    void Profiler::stopCapture()
+    {
+        m_capturing = false;
+    }
+
+    bool Profiler::exportChromeTrace(std::string const &filename) const
+    {
+        std::string out = "{\"traceEvents\":[\n";
+        char buf[128];
+        for (std::size_t i = 0; i < m_events.size(); ++i)
+        {
+            auto const &e = m_events[i];
+            std::string name = (e.name < NUM_SECTIONS) ? sectionName(static_cast<Section>(e.name))
+                                                        : m_bindings[e.name - NUM_SECTIONS].name;
+            char const *cat = (e.name < NUM_SECTIONS) ? "section" : "binding";
+            std::snprintf(buf, sizeof(buf), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n",
+                          e.t0 * 1.0e6, (e.t1 - e.t0) * 1.0e6, (i + 1 < m_events.size()) ? "," : "");
+            out += std::string("{\"name\":\"") + jsonEscape(name) + "\",\"cat\":\"" + cat + buf;
+        }
+        out += "],\"displayTimeUnit\":\"ms\"}\n";
+        return yg::file::writeFile(filename, &out[0], out.size()) == 0;
+    }
+
+    void Profiler::addBindingCall(int binding, double t0, double t1)
+    {
+        BindingStats &b = m_bindings[binding];
+        ++b.calls;
+        b.seconds += t1 - t0;
+        if (m_capturing && m_events.size() < maxCapturedEvents)
+        {
+            m_events.push_back({NUM_SECTIONS + binding, t0, t1});
+        }
+    }
+
+    void Profiler::addLuaSample(lua_State *L, lua_Debug *ar)
+    {
+        if (lua_getinfo(L, "S", ar) == 0)
+        {
+            return;
+        }
+        char key[LUA_IDSIZE + 16];
+        std::snprintf(key, sizeof(key), "%s:%d", ar->short_src, ar->linedefined);
+        ++m_luaSamples[key];
+        ++m_numLuaSamples;
+    }
+
+    double Profiler::now() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_epoch).count();
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef YGIF_PROFILER_H
+#define YGIF_PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // frame-time profiler of the host: per-frame section times, call counts and
+    // times of the Lua bindings, sampled Lua functions and Lua memory.
+    // a capture of the sections and binding calls can be exported as Chrome
+    // trace (chrome://tracing, Perfetto).
+    class Profiler
+    {
+    public:
+        enum Section
+        {
+            SECTION_TICK_LUA, // excluding SECTION_DRAW
+            SECTION_DRAW,     // draw submission
+            SECTION_RENDER_IMGUI,
+            SECTION_OTHER, // rest of the frame: GL swap, vsync, yourgame
+            NUM_SECTIONS
+        };
+
+        static const int historySize = 240; // frames
+
+        struct BindingStats
+        {
+            std::string name;
+            unsigned long calls = 0;
+            double seconds = 0.0;
+        };
+
+        // marks the start of a new frame. frameDelta is the duration of the
+        // previous frame [s], L (if not nullptr) the Lua state to read the memory of
+        void beginFrame(double frameDelta, lua_State *L);
+
+        void beginSection(Section s);
+        void endSection(Section s);
+
+        // replaces every function in the yg namespace (including class methods)
+        // with a wrapper that counts calls and time. call after registerLua().
+        void wrapBindings(lua_State *L);
+
+        // sampling: the count hook of the runtime (see applyLuaSettings())
+        // counts the running Lua function every 1000 instructions
+        void enableSampling(bool enable) { m_sampling = enable; }
+        bool isSampling() const { return m_sampling; }
+
+        void resetStats();
+
+        // history of section s [ms] and of the Lua memory [KiB], oldest first,
+        // historySize entries
+        std::vector<float> sectionHistory(Section s) const { return unrollHistory(m_history[s]); }
+        std::vector<float> luaMemoryHistory() const { return unrollHistory(m_luaMemKiB); }
+        static char const *sectionName(Section s);
+
+        std::vector<BindingStats> const &bindingStats() const { return m_bindings; }
+
+        // sampled Lua functions ("source:line") and their number of samples
+        std::unordered_map<std::string, unsigned long> const &luaSamples() const { return m_luaSamples; }
+        unsigned long numLuaSamples() const { return m_numLuaSamples; }
+
+        // geometry draws submitted and culled by gl_draw() and DrawList,
+        // counted during the frame. *LastFrame(): of the previous frame
+        void countDraws(int drawn, int culled)
+        {
+            m_drawn += drawn;
+            m_culled += culled;
+        }
+        int drawnLastFrame() const { return m_drawnLastFrame; }
+        int culledLastFrame() const { return m_culledLastFrame; }
+
+        void startCapture();
+        void stopCapture();
+        bool isCapturing() const { return m_capturing; }
+        std::size_t numCapturedEvents() const { return m_events.size(); }
+
+        // writes the captured events as Chrome trace json via yg::file
+        bool exportChromeTrace(std::string const &filename) const;
+
+        // called by the binding wrappers and the count hook
+        void addBindingCall(int binding, double t0, double t1);
+        void addLuaSample(lua_State *L, lua_Debug *ar);
+
+        // seconds since the profiler was created
+        double now() const;
+
+    private:
+        struct TraceEvent
+        {
+            int name; // section, or NUM_SECTIONS + binding
+            double t0;
+            double t1;
+        };
+
+        void wrapTable(lua_State *L, int tbl, std::string const &prefix, std::unordered_set<void const *> &visited);
+        std::vector<float> unrollHistory(std::vector<float> const &ring) const;
+
+        std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+
+        double m_sectionStart[NUM_SECTIONS] = {};
+        double m_sectionTime[NUM_SECTIONS] = {}; // current frame
+        std::vector<float> m_history[NUM_SECTIONS];
+        std::vector<float> m_luaMemKiB;
+        int m_historyPos = 0;
+
+        std::vector<BindingStats> m_bindings;
+        std::unordered_map<std::string, int> m_bindingSlots; // name -> m_bindings, kept across Lua states
+
+        int m_drawn = 0;
+        int m_culled = 0;
+        int m_drawnLastFrame = 0;
+        int m_culledLastFrame = 0;
+
+        bool m_sampling = false;
+        std::unordered_map<std::string, unsigned long> m_luaSamples;
+        unsigned long m_numLuaSamples = 0;
+
+        bool m_capturing = false;
+        std::vector<TraceEvent> m_events;
+    };
+
+    extern Profiler g_profiler;
+
+    // times a section from construction to destruction
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(Profiler::Section s) : m_section(s) { g_profiler.beginSection(s); }
+        ~ProfileScope() { g_profiler.endSection(m_section); }
+
+    private:
+        Profiler::Section m_section;
+    };
+}
+
+#endif
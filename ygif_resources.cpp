@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cstdio>
+#include "ygif_resources.h"
+#include "ygif_culling.h"
+#include "ygif_host.h"
+#include "ygif_hash.h"
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        // "a//sub/x.obj" -> "s//.meshcache_a__sub_x.ygmesh". always in the
+        // savefiles directory: the project directory is the user's, and is watched
+        std::string getMeshCacheFilename(std::string const &filename)
+        {
+            std::string name = filename.substr(0, filename.rfind('.'));
+            for (auto &c : name)
+            {
+                if (c == '/' || c == '\\' || c == ':')
+                {
+                    c = '_';
+                }
+            }
+            return "s//.meshcache_" + name + ".ygmesh";
+        }
+
+        // writes a temporary file and renames it to cacheName (s//...), so
+        // that mappings of the previous file (by prepare() on workers) stay valid
+        bool writeMeshCache(std::string const &cacheName, std::vector<uint8_t> const &data)
+        {
+            std::string tmpName = cacheName + ".tmp";
+            if (yg::file::writeFile(tmpName, &data[0], data.size()) != 0)
+            {
+                return false;
+            }
+            std::string path = yg::file::getSaveFilePath(cacheName.substr(3));
+            std::string tmpPath = yg::file::getSaveFilePath(tmpName.substr(3));
+            if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+            {
+                // windows: rename() does not replace an existing file
+                std::remove(path.c_str());
+                if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+                {
+                    std::remove(tmpPath.c_str());
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    ResourceCache::Request ResourceCache::geometryRequest(std::string const &filename)
+    {
+        Request req;
+        req.type = Type::GEOMETRY;
+        req.key = filename;
+        req.filenames = {filename};
+        return req;
+    }
+
+    ResourceCache::Request ResourceCache::vertFragShaderRequest(std::string const &vertFilename, std::string const &fragFilename)
+    {
+        Request req;
+        req.type = Type::SHADER;
+        req.key = vertFilename + "|" + fragFilename;
+        req.filenames = {vertFilename, fragFilename};
+        return req;
+    }
+
+    ResourceCache::Request ResourceCache::audioFileRequest(std::string const &filename)
+    {
+        Request req;
+        req.type = Type::AUDIO;
+        req.key = filename;
+        req.filenames = {filename};
+        return req;
+    }
+
+    void ResourceCache::prepare(Request &req)
+    {
+        prepareHash(req);
+        prepareMesh(req);
+    }
+
+    // FNV-1a over the content of all files
+    void ResourceCache::prepareHash(Request &req)
+    {
+        if (req.hashDone)
+        {
+            return;
+        }
+        req.hashDone = true;
+        req.hashed = true;
+        req.hash = fnv1a64Basis;
+        req.bytes = 0;
+        for (auto const &f : req.filenames)
+        {
+            std::vector<uint8_t> data;
+            if (yg::file::readFile(f, data) != 0)
+            {
+                req.hashed = false;
+                return;
+            }
+            if (!data.empty())
+            {
+                req.hash = hashFnv1a64(&data[0], data.size(), req.hash);
+            }
+            req.bytes += data.size();
+            if (req.type == Type::GEOMETRY)
+            {
+                req.source.swap(data);
+            }
+        }
+    }
+
+    // binary mesh of an .obj geometry: the prebuilt <name>.ygmesh beside it
+    // (ygif_meshc), or the mesh cache. converts the .obj if both are missing
+    // or stale, acquire() writes it to the cache. no mesh if the .obj can not
+    // be converted
+    void ResourceCache::prepareMesh(Request &req)
+    {
+        if (req.meshDone || req.type != Type::GEOMETRY)
+        {
+            return;
+        }
+        req.meshDone = true;
+        prepareHash(req);
+
+        std::string const &filename = req.filenames[0];
+        auto ext = filename.rfind('.');
+        if (ext == std::string::npos || filename.compare(ext, std::string::npos, ".obj") != 0)
+        {
+            return;
+        }
+
+        std::string meshFilenames[2] = {filename.substr(0, ext) + ".ygmesh", getMeshCacheFilename(filename)};
+        for (auto const &meshFilename : meshFilenames)
+        {
+            std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+            if (file->open(meshFilename) &&
+                parseMesh(file->data(), file->size(), req.mesh) &&
+                (!req.hashed || req.mesh.header->sourceHash == req.hash))
+            {
+                req.meshFile = file;
+                return;
+            }
+            req.mesh = MeshView();
+        }
+
+        if (!req.hashed || req.source.empty())
+        {
+            return;
+        }
+
+        std::string err;
+        if (!convertObjToMesh(reinterpret_cast<char const *>(&req.source[0]), req.source.size(), req.hash, req.meshData, &err))
+        {
+            yg::log::debug("%v: %v, using yg::gl::loadGeometry()", filename, err);
+            return;
+        }
+        req.meshCacheStale = true;
+        parseMesh(&req.meshData[0], req.meshData.size(), req.mesh);
+    }
+
+    bool ResourceCache::acquire(Request &req, void *&resource)
+    {
+        resource = nullptr;
+        prepareHash(req);
+
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (!it->current || it->type != req.type || it->key != req.key)
+            {
+                continue;
+            }
+
+            if (req.hashed && it->hash == req.hash)
+            {
+                ++(it->refs);
+                resource = it->resource;
+                return true;
+            }
+
+            // files changed: keep the old instance while it is referenced
+            it->current = false;
+            if (it->refs <= 0 && it->type != Type::AUDIO)
+            {
+                freeEntry(*it);
+                m_entries.erase(it);
+            }
+            break;
+        }
+
+        Entry e = {req.type, req.key, req.hash, req.bytes, 1, req.hashed, nullptr};
+        switch (req.type)
+        {
+        case Type::GEOMETRY:
+        {
+            prepareMesh(req);
+            if (req.meshCacheStale)
+            {
+                // main thread only: no concurrent writers of the cache
+                req.meshCacheStale = false;
+                std::string cacheName = getMeshCacheFilename(req.filenames[0]);
+                if (!writeMeshCache(cacheName, req.meshData))
+                {
+                    yg::log::warn("failed to write mesh cache %v", cacheName);
+                }
+            }
+            e.resource = (req.mesh.header != nullptr) ? host::makeGeometry(req.mesh)
+                                                      : host::loadGeometry(req.filenames[0]);
+
+            // bounds for frustum culling
+            Bounds b;
+            MeshHeader const *h = req.mesh.header;
+            if (e.resource != nullptr && h != nullptr)
+            {
+                b.min = glm::vec3(h->boundsMin[0], h->boundsMin[1], h->boundsMin[2]);
+                b.max = glm::vec3(h->boundsMax[0], h->boundsMax[1], h->boundsMax[2]);
+                setGeometryBounds(static_cast<yg::gl::Geometry *>(e.resource), b);
+            }
+            else if (e.resource != nullptr && h == nullptr && !req.source.empty() &&
+                     computeObjBounds(reinterpret_cast<char const *>(&req.source[0]), req.source.size(), &b.min[0], &b.max[0]))
+            {
+                setGeometryBounds(static_cast<yg::gl::Geometry *>(e.resource), b);
+            }
+            break;
+        }
+        case Type::SHADER:
+            e.resource = host::loadVertFragShader(req.filenames[0], req.filenames[1]);
+            break;
+        case Type::AUDIO:
+            // no instance: the file is addressed by name via yg::audio
+            if (!host::audioStoreFile(req.filenames[0]))
+            {
+                return false;
+            }
+            m_entries.push_back(e);
+            return true;
+        }
+
+        if (e.resource == nullptr)
+        {
+            return false;
+        }
+        m_entries.push_back(e);
+        resource = e.resource;
+        return true;
+    }
+
+    yg::gl::Geometry *ResourceCache::acquireGeometry(std::string const &filename)
+    {
+        Request req = geometryRequest(filename);
+        void *resource;
+        acquire(req, resource);
+        return static_cast<yg::gl::Geometry *>(resource);
+    }
+
+    yg::gl::Shader *ResourceCache::acquireVertFragShader(std::string const &vertFilename, std::string const &fragFilename)
+    {
+        Request req = vertFragShaderRequest(vertFilename, fragFilename);
+        void *resource;
+        acquire(req, resource);
+        return static_cast<yg::gl::Shader *>(resource);
+    }
+
+    bool ResourceCache::acquireAudioFile(std::string const &filename)
+    {
+        Request req = audioFileRequest(filename);
+        void *resource;
+        return acquire(req, resource);
+    }
+
+    bool ResourceCache::release(void const *resource)
+    {
+        if (resource == nullptr)
+        {
+            return false;
+        }
+
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->resource == resource)
+            {
+                if (--(it->refs) <= 0)
+                {
+                    freeEntry(*it);
+                    m_entries.erase(it);
+                    return true;
+                }
+                return false;
+            }
+        }
+        return false;
+    }
+
+    void ResourceCache::releaseAll()
+    {
+        for (auto &e : m_entries)
+        {
+            e.refs = 0;
+        }
+    }
+
+    void ResourceCache::purge()
+    {
+        auto unused = [](Entry const &e) {
+            return e.refs <= 0 && (e.type != Type::AUDIO || !e.current);
+        };
+        for (auto const &e : m_entries)
+        {
+            if (unused(e))
+            {
+                freeEntry(e);
+            }
+        }
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), unused), m_entries.end());
+    }
+
+    ResourceCache::Stats ResourceCache::stats() const
+    {
+        Stats s;
+        for (auto const &e : m_entries)
+        {
+            switch (e.type)
+            {
+            case Type::GEOMETRY:
+                ++s.geometries;
+                break;
+            case Type::SHADER:
+                ++s.shaders;
+                break;
+            case Type::AUDIO:
+                ++s.audioFiles;
+                break;
+            }
+            s.refs += std::max(e.refs, 0);
+            s.bytes += e.bytes;
+        }
+        return s;
+    }
+
+    bool ResourceCache::usesFile(std::string const &filename) const
+    {
+        for (auto const &e : m_entries)
+        {
+            if (e.refs <= 0)
+            {
+                continue;
+            }
+            // key: filename, or vertFilename|fragFilename
+            std::size_t pos = e.key.find(filename);
+            std::size_t end = pos + filename.size();
+            if (pos != std::string::npos &&
+                (pos == 0 || e.key[pos - 1] == '|') &&
+                (end == e.key.size() || e.key[end] == '|'))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ResourceCache::isLive(void const *resource) const
+    {
+        for (auto const &e : m_entries)
+        {
+            if (e.resource == resource)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ResourceCache::freeEntry(Entry const &e)
+    {
+        if (e.resource != nullptr)
+        {
+            ++m_frees;
+        }
+        switch (e.type)
+        {
+        case Type::GEOMETRY:
+            clearGeometryBounds(static_cast<yg::gl::Geometry *>(e.resource));
+            host::freeGeometry(static_cast<yg::gl::Geometry *>(e.resource));
+            break;
+        case Type::SHADER:
+            host::freeShader(static_cast<yg::gl::Shader *>(e.resource));
+            break;
+        case Type::AUDIO:
+            break;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef YGIF_RESOURCES_H
+#define YGIF_RESOURCES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_mappedfile.h"
+#include "ygif_mesh.h"
+
+namespace mygame
+{
+    // host-side cache of the resources loaded by Lua (geometries, shaders,
+    // audio files), keyed by file path(s) and a hash of the file content.
+    // acquiring an unchanged resource again returns the shared instance and
+    // increments its refcount. a resource is freed when its refcount drops
+    // to 0 via release(). when the Lua state closes, releaseAll() drops all
+    // refcounts but keeps the resources for reuse by the next Lua state,
+    // purge() frees the ones that were not acquired again. release() and
+    // purge() free GL resources, call them while the GL context exists.
+    // holders of resource pointers outside of Lua check frees() and isLive()
+    // before using them (see DrawList).
+    class ResourceCache
+    {
+    public:
+        struct Stats
+        {
+            int geometries = 0;
+            int shaders = 0;
+            int audioFiles = 0;
+            int refs = 0;
+            std::size_t bytes = 0; // size of the source files
+        };
+
+        enum class Type
+        {
+            GEOMETRY,
+            SHADER,
+            AUDIO
+        };
+
+        // a resource to acquire. acquiring is split in two steps:
+        // prepare() reads the files, hashes them and converts meshes. it does
+        // not touch the cache (nor write the mesh cache) and can run on a
+        // worker thread. acquire() does the rest (cache lookup, mesh cache
+        // write, GL uploads) on the main thread, and prepares the request
+        // itself, if needed.
+        struct Request
+        {
+            Type type;
+            std::string key;
+            std::vector<std::string> filenames;
+
+            bool hashDone = false;
+            bool hashed = false; // false if a file was not readable
+            uint64_t hash = 0;
+            std::size_t bytes = 0;
+            std::vector<uint8_t> source; // geometry: content of the .obj
+
+            bool meshDone = false;
+            std::shared_ptr<MappedFile> meshFile; // prebuilt or cached mesh
+            std::vector<uint8_t> meshData;        // converted mesh
+            bool meshCacheStale = false;          // meshData is written to the cache by acquire()
+            MeshView mesh;                        // header == nullptr: no mesh
+        };
+
+        static Request geometryRequest(std::string const &filename);
+        static Request vertFragShaderRequest(std::string const &vertFilename, std::string const &fragFilename);
+        static Request audioFileRequest(std::string const &filename);
+
+        static void prepare(Request &req);
+
+        // returns false if loading failed. resource is nullptr for audio files
+        bool acquire(Request &req, void *&resource);
+
+        // return nullptr if loading failed
+        yourgame::gl::Geometry *acquireGeometry(std::string const &filename);
+        yourgame::gl::Shader *acquireVertFragShader(std::string const &vertFilename, std::string const &fragFilename);
+
+        // stores filename in yg::audio, if not stored with the same content yet.
+        // audio files are never freed, yg::audio provides no way to do so
+        bool acquireAudioFile(std::string const &filename);
+
+        // decrements the refcount of resource, frees it if it drops to 0.
+        // returns true if it was freed
+        bool release(void const *resource);
+
+        void releaseAll();
+        void purge();
+
+        Stats stats() const;
+
+        // true if a resource in use (refcount > 0) was loaded from filename
+        bool usesFile(std::string const &filename) const;
+
+        // true if resource is held by the cache (not freed yet)
+        bool isLive(void const *resource) const;
+
+        // number of resources freed so far: if unchanged, pointers to
+        // resources taken earlier are still valid
+        unsigned long frees() const { return m_frees; }
+
+    private:
+        struct Entry
+        {
+            Type type;
+            std::string key;
+            uint64_t hash;
+            std::size_t bytes;
+            int refs;
+            bool current; // false if the files changed after it was loaded
+            void *resource;
+        };
+
+        static void prepareHash(Request &req);
+        static void prepareMesh(Request &req);
+        void freeEntry(Entry const &e);
+
+        std::vector<Entry> m_entries;
+        unsigned long m_frees = 0;
+    };
+}
+
+#endif
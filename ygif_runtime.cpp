@@ -0,0 +1,460 @@
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "yourgame/yourgame.h"
+#include "ygif_runtime.h"
+#include "ygif_glue.h"
+#include "ygif_ffi.h"
+#include "ygif_host.h"
+#include "ygif_loader.h"
+#include "ygif_async.h"
+#include "ygif_profiler.h"
+#include "ygif_glstate.h"
+#include "ygif_luaalloc.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+
+using json = nlohmann::json;
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    std::string g_luaScriptName = "main.lua";
+    std::string g_flavorName = "main_flavor.json";
+    lua_State *g_Lua = nullptr;
+    json g_flavor;
+    FlavorStore g_flavorParams;
+    ResourceCache g_resources;
+    TaskScheduler g_tasks;
+    double g_asyncLoadBudget = 0.004;
+    bool g_profileBindings = false;
+    LuaSettings g_luaSettings;
+    LuaAllocator g_luaAlloc;
+
+    namespace
+    {
+        // registry refs to the script callbacks, resolved in resolveLuaCallbacks()
+        int g_refInit = LUA_NOREF;
+        int g_refTick = LUA_NOREF;
+        int g_refShutdown = LUA_NOREF;
+
+        // count hook shared by the tick watchdog and the profiler
+        int const luaHookInterval = 1000; // instructions
+        bool g_tickRunning = false;
+        bool g_tickAborted = false; // by the watchdog
+        std::chrono::steady_clock::time_point g_tickStart;
+        unsigned long g_tickInstructions = 0;
+
+        // stepGc() does not step while the heap is below [KiB], after it
+        // finished a cycle
+        int g_gcIdleKb = 0;
+
+        void luaHook(lua_State *L, lua_Debug *ar)
+        {
+            if (g_profiler.isSampling())
+            {
+                g_profiler.addLuaSample(L, ar);
+            }
+
+            if (g_tickRunning)
+            {
+                // keeps raising once exceeded, also if the script catches the error
+                g_tickInstructions += luaHookInterval;
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - g_tickStart).count();
+                if (g_luaSettings.tickTimeLimit > 0.0 && elapsed > g_luaSettings.tickTimeLimit)
+                {
+                    g_tickAborted = true;
+                    luaL_error(L, "tick() aborted: time limit of %f ms exceeded",
+                               g_luaSettings.tickTimeLimit * 1000.0);
+                }
+                if (g_luaSettings.tickInstructionLimit > 0 && g_tickInstructions > g_luaSettings.tickInstructionLimit)
+                {
+                    g_tickAborted = true;
+                    luaL_error(L, "tick() aborted: instruction limit of %d exceeded",
+                               static_cast<int>(g_luaSettings.tickInstructionLimit));
+                }
+            }
+        }
+
+        // GC steps until budget [s] is used or a cycle finished. after a
+        // finished cycle, no steps until the heap grew by gcPause, like the
+        // collector itself: a step between cycles would start a new one
+        void stepGc(lua_State *L, double budget)
+        {
+            if (lua_gc(L, LUA_GCCOUNT, 0) < g_gcIdleKb)
+            {
+                return;
+            }
+            g_gcIdleKb = 0;
+
+            auto t0 = std::chrono::steady_clock::now();
+            do
+            {
+                if (lua_gc(L, LUA_GCSTEP, 0) != 0)
+                {
+                    g_gcIdleKb = static_cast<int>(lua_gc(L, LUA_GCCOUNT, 0) * (g_luaSettings.gcPause / 100.0));
+                    return;
+                }
+            } while (std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() < budget);
+        }
+
+        // unprotected error (outside of lua_pcall()), Lua aborts after this
+        int luaPanic(lua_State *L)
+        {
+            char const *msg = lua_tostring(L, -1);
+            yg::log::error("Lua panic: %v", (msg != nullptr) ? msg : "(error object is not a string)");
+            return 0;
+        }
+
+        // lua_pcall() message handler: appends a traceback to the error message
+        int luaMsgHandler(lua_State *L)
+        {
+            char const *msg = lua_tostring(L, 1);
+            luaL_traceback(L, L, (msg != nullptr) ? msg : "(error object is not a string)", 1);
+            return 1;
+        }
+
+        // replaces *ref with a ref to the global function name, or LUA_NOREF
+        void resolveCallback(lua_State *L, char const *name, int *ref)
+        {
+            luaL_unref(L, LUA_REGISTRYINDEX, *ref);
+            *ref = LUA_NOREF;
+            lua_getglobal(L, name);
+            if (lua_isfunction(L, -1))
+            {
+                *ref = luaL_ref(L, LUA_REGISTRYINDEX); // pops the function
+            }
+            else
+            {
+                lua_pop(L, 1);
+            }
+        }
+
+        // calls the callback ref with nargs numbers from args.
+        // returns false if the callback raised an error.
+        bool callCallback(lua_State *L, int ref, char const *name, int nargs, double const *args)
+        {
+            if (ref == LUA_NOREF)
+            {
+                return true;
+            }
+
+            lua_pushcfunction(L, luaMsgHandler);
+            int msgHandlerIdx = lua_gettop(L);
+            lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+            for (int i = 0; i < nargs; ++i)
+            {
+                lua_pushnumber(L, args[i]);
+            }
+
+            bool ok = (lua_pcall(L, nargs, 0, msgHandlerIdx) == LUA_OK);
+            if (!ok)
+            {
+                yg::log::error("%v(): Lua error: %v", name, lua_tostring(L, -1));
+                lua_pop(L, 1); // error message
+            }
+            lua_pop(L, 1); // message handler
+            return ok;
+        }
+    }
+
+    void resolveLuaCallbacks()
+    {
+        if (g_Lua != nullptr)
+        {
+            resolveCallback(g_Lua, "init", &g_refInit);
+            resolveCallback(g_Lua, "tick", &g_refTick);
+            resolveCallback(g_Lua, "shutdown", &g_refShutdown);
+        }
+    }
+
+    void initLua()
+    {
+        if (g_Lua == nullptr)
+        {
+            // initialize Lua, register C++ components
+            g_Lua = lua_newstate(LuaAllocator::alloc, &g_luaAlloc);
+            if (g_Lua == nullptr)
+            {
+                // LuaJIT without GC64 (64 bit): own allocator only
+                yg::log::warn("initLua(): lua_newstate() failed, using the default allocator");
+                g_Lua = luaL_newstate();
+            }
+            lua_atpanic(g_Lua, luaPanic);
+            luaL_openlibs(g_Lua);
+            mygame::registerLua(g_Lua);
+            registerFfi(g_Lua);
+            registerLuaSearcher(g_Lua);
+            if (g_profileBindings)
+            {
+                g_profiler.wrapBindings(g_Lua);
+            }
+            applyLuaSettings();
+
+            // run Lua code
+            {
+                // load initial Lua script from assets, or project path, if set
+                std::string luaScriptName = "a//" + g_luaScriptName;
+                if (yg::file::getProjectFilePath("") != "")
+                {
+                    luaScriptName = "p//" + g_luaScriptName;
+                }
+
+                // load lua script (bytecode cached) and run it
+                if (loadLuaChunk(g_Lua, luaScriptName) != LUA_OK ||
+                    lua_pcall(g_Lua, 0, 0, 0) != LUA_OK)
+                {
+                    yg::log::error("Lua error: %v", lua_tostring(g_Lua, -1));
+                    shutdownLua();
+                }
+                else
+                {
+                    // resolve init(), tick() and shutdown(), call init(). init()
+                    // may define or replace tick() and shutdown(): resolved again
+                    resolveLuaCallbacks();
+                    if (!callCallback(g_Lua, g_refInit, "init", 0, nullptr))
+                    {
+                        shutdownLua();
+                    }
+                    else
+                    {
+                        resolveCallback(g_Lua, "tick", &g_refTick);
+                        resolveCallback(g_Lua, "shutdown", &g_refShutdown);
+                    }
+
+                    // free resources of the previous Lua state, that init() did not reuse
+                    g_resources.purge();
+                }
+            }
+        }
+        else
+        {
+            yg::log::error("initLua(): g_Lua != nullptr");
+        }
+    }
+
+    void tickLua()
+    {
+        // also runs the jobs of the job pool on platforms without workers
+        updateAsyncLoads(g_asyncLoadBudget);
+        g_glState.beginFrame();
+        g_luaAlloc.beginTick();
+
+        if (g_Lua != nullptr)
+        {
+            // Lua: resume due tasks, call tick(dt, time). watched by luaHook()
+            double args[2] = {host::timeGetDelta(), host::timeGetTime()};
+            g_tickStart = std::chrono::steady_clock::now();
+            g_tickInstructions = 0;
+            g_tickAborted = false;
+            g_tickRunning = true;
+            bool ok = g_tasks.update(g_Lua) &&
+                      callCallback(g_Lua, g_refTick, "tick", 2, args);
+            g_tickRunning = false;
+            if (!ok && !g_tickAborted)
+            {
+                shutdownLua();
+            }
+            else if (!ok)
+            {
+                // watchdog: the Lua state is kept, tick() runs again next frame
+                yg::log::warn("tickLua(): tick aborted by the watchdog, Lua state kept");
+            }
+            else if (g_luaSettings.gcStepBudget > 0.0 &&
+                     g_luaSettings.gcMode != LuaSettings::GcMode::GENERATIONAL)
+            {
+                stepGc(g_Lua, g_luaSettings.gcStepBudget);
+            }
+        }
+    }
+
+    void applyLuaSettings()
+    {
+        if (g_Lua == nullptr)
+        {
+            return;
+        }
+
+        bool hook = g_profiler.isSampling() ||
+                    g_luaSettings.tickTimeLimit > 0.0 ||
+                    g_luaSettings.tickInstructionLimit > 0;
+        lua_sethook(g_Lua, hook ? luaHook : nullptr, hook ? LUA_MASKCOUNT : 0, luaHookInterval);
+        g_luaAlloc.setLimit(g_luaSettings.memoryLimit);
+
+#if LUA_VERSION_NUM >= 504
+        if (g_luaSettings.gcMode == LuaSettings::GcMode::GENERATIONAL)
+        {
+            lua_gc(g_Lua, LUA_GCGEN, 0, 0); // default multipliers
+        }
+        else
+        {
+            lua_gc(g_Lua, LUA_GCINC, g_luaSettings.gcPause, g_luaSettings.gcStepMul, 0);
+        }
+#else
+        lua_gc(g_Lua, LUA_GCSETPAUSE, g_luaSettings.gcPause);
+        lua_gc(g_Lua, LUA_GCSETSTEPMUL, g_luaSettings.gcStepMul);
+#endif
+        lua_gc(g_Lua, (g_luaSettings.gcMode == LuaSettings::GcMode::MANUAL) ? LUA_GCSTOP : LUA_GCRESTART, 0);
+    }
+
+    int reloadLua(std::vector<std::string> const *changedFiles)
+    {
+        if (g_Lua == nullptr)
+        {
+            return 0;
+        }
+
+        // copy: re-executed chunks may require() new modules
+        std::vector<LuaChunkInfo> chunks = getLuaChunks();
+        int numReloaded = 0;
+        for (auto const &chunk : chunks)
+        {
+            // only the project directory is watched
+            // changedFiles lists the files directly in p//, modules in
+            // subdirectories are always checked
+            bool inList = (changedFiles == nullptr) ||
+                          (chunk.filename.find('/', 3) != std::string::npos) ||
+                          (std::find(changedFiles->begin(), changedFiles->end(), chunk.filename) != changedFiles->end());
+            if (chunk.filename.compare(0, 3, "p//") != 0 || !inList || !luaChunkChanged(chunk))
+            {
+                continue;
+            }
+
+            ++numReloaded;
+            lua_pushcfunction(g_Lua, luaMsgHandler);
+            int msgHandlerIdx = lua_gettop(g_Lua);
+            if (loadLuaChunk(g_Lua, chunk.filename, chunk.modName) != LUA_OK)
+            {
+                yg::log::error("reloadLua(): %v", lua_tostring(g_Lua, -1));
+                lua_settop(g_Lua, msgHandlerIdx - 1);
+                continue;
+            }
+
+            // modules are called like require() does, their result replaces
+            // package.loaded[modName]
+            int nargs = 0;
+            if (!chunk.modName.empty())
+            {
+                lua_pushstring(g_Lua, chunk.modName.c_str());
+                lua_pushstring(g_Lua, chunk.filename.c_str());
+                nargs = 2;
+            }
+            if (lua_pcall(g_Lua, nargs, 1, msgHandlerIdx) != LUA_OK)
+            {
+                yg::log::error("reloadLua(): Lua error: %v", lua_tostring(g_Lua, -1));
+            }
+            else if (!chunk.modName.empty() && !lua_isnil(g_Lua, -1))
+            {
+                lua_getglobal(g_Lua, "package");
+                lua_getfield(g_Lua, -1, "loaded");
+                lua_pushvalue(g_Lua, -3);
+                lua_setfield(g_Lua, -2, chunk.modName.c_str());
+                lua_pop(g_Lua, 2); // package.loaded, package
+            }
+            lua_settop(g_Lua, msgHandlerIdx - 1);
+            yg::log::info("reloaded %v", chunk.filename);
+        }
+
+        if (numReloaded > 0)
+        {
+            // re-executed code may redefine the callbacks. call the optional
+            // reload(), without caching it
+            resolveLuaCallbacks();
+            int refReload = LUA_NOREF;
+            resolveCallback(g_Lua, "reload", &refReload);
+            callCallback(g_Lua, refReload, "reload", 0, nullptr);
+            luaL_unref(g_Lua, LUA_REGISTRYINDEX, refReload);
+        }
+        return numReloaded;
+    }
+
+    void shutdownLua()
+    {
+        if (g_Lua != nullptr)
+        {
+            // Lua: call shutdown()
+            callCallback(g_Lua, g_refShutdown, "shutdown", 0, nullptr);
+
+            // refs are released with the registry of the closed state
+            g_refInit = LUA_NOREF;
+            g_refTick = LUA_NOREF;
+            g_refShutdown = LUA_NOREF;
+
+            lua_close(g_Lua);
+            g_Lua = nullptr;
+            g_luaAlloc.reset();
+            g_gcIdleKb = 0;
+            g_tasks.clear();
+            clearLuaChunks();
+            cancelAsyncLoads();
+
+            // keep resources for the next Lua state, see g_resources
+            g_resources.releaseAll();
+        }
+        else
+        {
+            yg::log::error("shutdownLua(): g_Lua == nullptr");
+        }
+    }
+
+    // flavor file from assets, or project path, if set
+    std::string getFlavorFilename()
+    {
+        if (yg::file::getProjectFilePath("") != "")
+        {
+            return "p//" + g_flavorName;
+        }
+        return "a//" + g_flavorName;
+    }
+
+    void loadFlavor()
+    {
+        {
+            // load initial flavor file from assets, or project path, if set
+            std::string flavorName = getFlavorFilename();
+
+            // load flavor file
+            std::vector<uint8_t> data;
+            if (yg::file::readFile(flavorName, data) == 0)
+            {
+                // add null terminator
+                data.push_back((uint8_t)0);
+            }
+            else
+            {
+                yg::log::error("failed to load flavor from file %v", flavorName);
+                return;
+            }
+
+            try
+            {
+                g_flavor = json::parse(&(data[0]));
+            }
+            catch (json::parse_error &e)
+            {
+                yg::log::warn("failed to parse json (flavor): %v", std::string(e.what()));
+                return;
+            }
+
+            // compile flavor into flat parameter store, used by Lua and the Flavor editor
+            g_flavorParams.load(g_flavor);
+        }
+    }
+
+    void saveFlavor()
+    {
+        g_flavorParams.save(g_flavor);
+        std::string flavorName = getFlavorFilename();
+        std::string dataStr = g_flavor.dump(4);
+        if (yg::file::writeFile(flavorName, &(dataStr[0]), dataStr.size()) != 0)
+        {
+            yg::log::error("failed to save flavor to file %v", flavorName);
+        }
+    }
+}
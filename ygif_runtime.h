@@ -0,0 +1,117 @@
+#ifndef YGIF_RUNTIME_H
+#define YGIF_RUNTIME_H
+
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "ygif_flavor.h"
+#include "ygif_luaalloc.h"
+#include "ygif_resources.h"
+#include "ygif_tasks.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // initial Lua script name to execute.
+    // if project path set: try to load p//<g_luaScriptName>
+    // else: try to load a//<g_luaScriptName>.
+    extern std::string g_luaScriptName;
+
+    // initial flavor to load.
+    // if project path set: try to load p//<g_flavorName>
+    // else: try to load a//<g_flavorName>.
+    extern std::string g_flavorName;
+
+    extern lua_State *g_Lua;
+    extern nlohmann::json g_flavor;
+    extern FlavorStore g_flavorParams; // compiled from g_flavor in loadFlavor()
+
+    // resources loaded by Lua. released when the Lua state closes, resources
+    // not acquired again by the next init() are freed after it
+    extern ResourceCache g_resources;
+
+    // tasks of g_Lua (yg.task), resumed in tickLua() before tick()
+    extern TaskScheduler g_tasks;
+
+    // time per frame [s] for finishing asynchronous loads (GL uploads) in tickLua()
+    extern double g_asyncLoadBudget;
+
+    // if true, initLua() wraps the yg bindings for g_profiler (call counts
+    // and times), at the cost of one extra call per binding call. off by
+    // default, switched on in the Profiler window (restarts Lua)
+    extern bool g_profileBindings;
+
+    // per-tick limits and GC pacing of g_Lua. applied by initLua(), call
+    // applyLuaSettings() after changing them while g_Lua exists
+    struct LuaSettings
+    {
+        enum class GcMode
+        {
+            INCREMENTAL,  // collector driven by allocations (Lua default)
+            GENERATIONAL, // Lua 5.4 only, incremental with older versions
+            MANUAL        // collector stopped, only the steps of gcStepBudget
+        };
+
+        // watchdog: tick() (including the tasks) is aborted with an error if it
+        // runs longer than tickTimeLimit [s] or executes more than
+        // tickInstructionLimit instructions (checked every 1000 instructions).
+        // the time includes blocking calls (LoadHandle:get(), sync loads).
+        // the Lua state is kept, tick() is called again in the next frame.
+        // 0: no limit (default)
+        double tickTimeLimit = 0.0;
+        unsigned long tickInstructionLimit = 0;
+
+        GcMode gcMode = GcMode::INCREMENTAL;
+        int gcPause = 200;   // incremental: memory growth [%] before a new cycle starts
+        int gcStepMul = 100; // incremental: collector speed relative to allocation [%]
+
+        // time [s] for GC steps at the end of each tickLua(), spreading the
+        // collection over the frames. between cycles, no steps until the heap
+        // grew by gcPause. not used in generational mode. 0: off
+        double gcStepBudget = 0.001;
+
+        // hard cap of the Lua heap [bytes], see LuaAllocator. 0: no limit
+        std::size_t memoryLimit = 0;
+    };
+
+    extern LuaSettings g_luaSettings;
+
+    // allocator of g_Lua: memory stats, reset when g_Lua closes
+    extern LuaAllocator g_luaAlloc;
+
+    // Lua state lifecycle: create state, register C++ components, run script
+    // and call init(), tick(dt, time) and shutdown() defined by the script.
+    // the script functions are resolved after the script ran and kept as
+    // registry refs, tick() and shutdown() again after init() returned.
+    void initLua();
+    void tickLua();
+    void shutdownLua();
+
+    // applies g_luaSettings and the sampling flag of g_profiler to g_Lua.
+    // the watchdog and the profiler share one count hook
+    void applyLuaSettings();
+
+    // incremental hot reload: re-executes the scripts in p// (main script and
+    // require()d modules) that changed since they were loaded, in the existing
+    // Lua state. globals and loaded resources are kept, init() is not called
+    // again. calls reload(), if defined by the script, after changes.
+    // changedFiles: changed files directly in p// (from a FileIndex), other
+    // scripts there are not checked. nullptr: all are checked.
+    // returns the number of re-executed scripts.
+    int reloadLua(std::vector<std::string> const *changedFiles = nullptr);
+
+    // re-resolves the init/tick/shutdown refs from the globals of g_Lua.
+    // call after running code that may redefine them (hot reload).
+    void resolveLuaCallbacks();
+
+    // p// flavor file if a project path is set, a// otherwise
+    std::string getFlavorFilename();
+    void loadFlavor();
+    void saveFlavor();
+}
+
+#endif
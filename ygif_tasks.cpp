@@ -0,0 +1,236 @@
+#include "yourgame/yourgame.h"
+#include "ygif_tasks.h"
+#include "ygif_host.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+namespace yg = yourgame; // convenience
+
+namespace mygame
+{
+    namespace
+    {
+        int resumeThread(lua_State *task, lua_State *from, int nargs)
+        {
+#if LUA_VERSION_NUM >= 504
+            int nresults;
+            return lua_resume(task, from, nargs, &nresults);
+#elif LUA_VERSION_NUM >= 502
+            return lua_resume(task, from, nargs);
+#else
+            (void)from;
+            return lua_resume(task, nargs);
+#endif
+        }
+
+        char const *notInTask = "yg.task: wait functions have to be called from a task";
+    }
+
+    int TaskScheduler::spawn(lua_State *L)
+    {
+        int nargs = lua_gettop(L) - 1;
+        lua_State *task = lua_newthread(L);
+        lua_pushvalue(L, -1);
+        m_tasks[task] = {luaL_ref(L, LUA_REGISTRYINDEX), 0}; // pops the thread copy
+
+        // fn, args
+        for (int i = 1; i <= nargs + 1; ++i)
+        {
+            lua_pushvalue(L, i);
+        }
+        lua_xmove(L, task, nargs + 1);
+
+        if (!resume(L, task, nargs))
+        {
+            return lua_error(L);
+        }
+        return 1; // the thread
+    }
+
+    int TaskScheduler::cancel(lua_State *L, lua_State *task)
+    {
+        if (task == L)
+        {
+            return luaL_error(L, "yg.task.cancel(): a task cannot cancel itself");
+        }
+
+        // heap entries of the task become stale, see isWaiting()
+        auto it = m_tasks.find(task);
+        bool found = (it != m_tasks.end());
+        if (found)
+        {
+            luaL_unref(L, LUA_REGISTRYINDEX, it->second.ref);
+            m_tasks.erase(it);
+        }
+        lua_pushboolean(L, found);
+        return 1;
+    }
+
+    int TaskScheduler::wait(lua_State *L, double seconds)
+    {
+        auto it = m_tasks.find(L);
+        if (it == m_tasks.end())
+        {
+            return luaL_error(L, notInTask);
+        }
+        uint64_t seq = ++m_seq;
+        m_timeWaits.push({host::timeGetTime() + seconds, seq, L});
+        return yieldTask(L, it->second, seq);
+    }
+
+    int TaskScheduler::waitFrames(lua_State *L, int frames)
+    {
+        auto it = m_tasks.find(L);
+        if (it == m_tasks.end())
+        {
+            return luaL_error(L, notInTask);
+        }
+        uint64_t seq = ++m_seq;
+        m_frameWaits.push({static_cast<double>(m_frame + ((frames > 1) ? frames : 1)), seq, L});
+        return yieldTask(L, it->second, seq);
+    }
+
+    int TaskScheduler::waitUntil(lua_State *L, LoadHandle const &handle)
+    {
+        auto it = m_tasks.find(L);
+        if (it == m_tasks.end())
+        {
+            return luaL_error(L, notInTask);
+        }
+        if (handle.isReady())
+        {
+            return 0;
+        }
+        uint64_t seq = ++m_seq;
+        m_loadWaits.push_back({handle, seq, L});
+        return yieldTask(L, it->second, seq);
+    }
+
+    bool TaskScheduler::update(lua_State *L)
+    {
+        ++m_frame;
+        double now = host::timeGetTime();
+
+        // collect the due tasks first: tasks waiting again while they are
+        // resumed below are due in the next frame, at the earliest
+        std::vector<Wake> due;
+        auto popDue = [&](WakeHeap &heap, double until) {
+            while (!heap.empty() && heap.top().at <= until && static_cast<int>(due.size()) < maxResumes)
+            {
+                if (isWaiting(heap.top().task, heap.top().seq))
+                {
+                    due.push_back(heap.top());
+                }
+                heap.pop();
+            }
+        };
+        popDue(m_timeWaits, now);
+        popDue(m_frameWaits, static_cast<double>(m_frame));
+
+        // load waits are polled, unordered
+        for (std::size_t i = 0; i < m_loadWaits.size();)
+        {
+            LoadWait &w = m_loadWaits[i];
+            bool stale = !isWaiting(w.task, w.seq);
+            bool ready = !stale && static_cast<int>(due.size()) < maxResumes && w.handle.isReady();
+            if (ready)
+            {
+                due.push_back({0.0, w.seq, w.task});
+            }
+            if (stale || ready)
+            {
+                w = m_loadWaits.back();
+                m_loadWaits.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        for (std::size_t i = 0; i < due.size(); ++i)
+        {
+            // a task resumed before may have cancelled this one
+            if (!isWaiting(due[i].task, due[i].seq))
+            {
+                continue;
+            }
+            if (!resume(L, due[i].task, 0))
+            {
+                yg::log::error("yg.task: Lua error: %v", lua_tostring(L, -1));
+                lua_pop(L, 1);
+
+                // the state may be kept (watchdog): the other due tasks are
+                // resumed in the next frame
+                for (std::size_t k = i + 1; k < due.size(); ++k)
+                {
+                    m_frameWaits.push({static_cast<double>(m_frame + 1), due[k].seq, due[k].task});
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TaskScheduler::clear()
+    {
+        // the threads are released with the registry of the closed state
+        m_tasks.clear();
+        m_timeWaits = WakeHeap();
+        m_frameWaits = WakeHeap();
+        m_loadWaits.clear();
+    }
+
+    int TaskScheduler::yieldTask(lua_State *L, Task &task, uint64_t seq)
+    {
+        task.waitSeq = seq;
+        return lua_yield(L, 0);
+    }
+
+    bool TaskScheduler::resume(lua_State *L, lua_State *task, int nargs)
+    {
+        // the task runs under the hook of the resuming state (watchdog, profiler)
+        lua_sethook(task, lua_gethook(L), lua_gethookmask(L), lua_gethookcount(L));
+
+        m_tasks[task].waitSeq = 0;
+        int status = resumeThread(task, L, nargs);
+
+        // the task may have been cancelled while it ran
+        auto it = m_tasks.find(task);
+        if (status == LUA_YIELD)
+        {
+            lua_settop(task, 0); // values of coroutine.yield()
+            if (it != m_tasks.end() && it->second.waitSeq == 0)
+            {
+                // yielded without a wait function: resume in the next frame
+                it->second.waitSeq = ++m_seq;
+                m_frameWaits.push({static_cast<double>(m_frame + 1), m_seq, task});
+            }
+            return true;
+        }
+
+        if (it != m_tasks.end())
+        {
+            luaL_unref(L, LUA_REGISTRYINDEX, it->second.ref);
+            m_tasks.erase(it);
+        }
+        if (status == LUA_OK)
+        {
+            return true;
+        }
+        char const *msg = lua_tostring(task, -1);
+        luaL_traceback(L, task, (msg != nullptr) ? msg : "(error object is not a string)", 0);
+        return false;
+    }
+
+    bool TaskScheduler::isWaiting(lua_State *task, uint64_t seq) const
+    {
+        auto it = m_tasks.find(task);
+        return it != m_tasks.end() && it->second.waitSeq == seq;
+    }
+}
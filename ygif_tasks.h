@@ -0,0 +1,89 @@
+#ifndef YGIF_TASKS_H
+#define YGIF_TASKS_H
+
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "ygif_async.h"
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // cooperative tasks of the Lua state (yg.task): coroutines that wait for
+    // a time, a number of frames or an asynchronous load. waiting tasks are
+    // kept in min-heaps of their wake-up time and frame, update() only
+    // touches the tasks that are due, sleeping tasks cost nothing.
+    class TaskScheduler
+    {
+    public:
+        // Lua functions (see registerLua()), arguments checked by the caller.
+        // the wait functions have to be called from a task, they yield
+
+        // fn(...) as new task, runs until it waits the first time. pushes its thread
+        int spawn(lua_State *L);
+        int cancel(lua_State *L, lua_State *task);
+        int wait(lua_State *L, double seconds);
+        int waitFrames(lua_State *L, int frames);
+        int waitUntil(lua_State *L, LoadHandle const &handle);
+
+        // once per frame: resumes the due tasks, at most maxResumes.
+        // returns false if a task raised an error (logged)
+        bool update(lua_State *L);
+
+        // drops all tasks, called when the Lua state closes
+        void clear();
+
+        std::size_t numTasks() const { return m_tasks.size(); }
+
+        // resumes per update(), further due tasks are resumed in the next frame
+        int maxResumes = 10000;
+
+    private:
+        struct Task
+        {
+            int ref;          // registry ref of the thread
+            uint64_t waitSeq; // of the current wait, 0: none
+        };
+
+        struct Wake
+        {
+            double at; // time [s] or frame
+            uint64_t seq;
+            lua_State *task;
+
+            bool operator>(Wake const &o) const { return (at != o.at) ? (at > o.at) : (seq > o.seq); }
+        };
+
+        struct LoadWait
+        {
+            LoadHandle handle;
+            uint64_t seq;
+            lua_State *task;
+        };
+
+        typedef std::priority_queue<Wake, std::vector<Wake>, std::greater<Wake>> WakeHeap;
+
+        // yields L after registering a wait with seq
+        int yieldTask(lua_State *L, Task &task, uint64_t seq);
+
+        // resumes task from L. on error, pushes the message to L and returns false
+        bool resume(lua_State *L, lua_State *task, int nargs);
+
+        // true if entry seq of task is still its current wait
+        bool isWaiting(lua_State *task, uint64_t seq) const;
+
+        std::unordered_map<lua_State *, Task> m_tasks;
+        WakeHeap m_timeWaits;
+        WakeHeap m_frameWaits;
+        std::vector<LoadWait> m_loadWaits;
+        uint64_t m_seq = 0;
+        uint64_t m_frame = 0;
+    };
+}
+
+#endif
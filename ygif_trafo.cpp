@@ -1,39 +1,160 @@
 #include "ygif_trafo.h"
+#include "ygif_glue.h"
+#include "ygif_vecmath.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lauxlib.h"
+}
 
 namespace mygame
 {
-    void YgifTrafo::rotateGlobal(float angle, std::string const &ax)
+    namespace
+    {
+        // reads axis yg.math.X/Y/Z (integer) or "X", "Y", "Z" (string) from
+        // the Lua stack at idx
+        bool toAxis(lua_State *L, int idx, yourgame::math::Axis &ax)
+        {
+            if (lua_type(L, idx) == LUA_TNUMBER)
+            {
+                lua_Integer i = -1;
+                if (!luaToIntegral(L, idx, i))
+                {
+                    return false;
+                }
+                switch (i)
+                {
+                case 0:
+                    ax = yourgame::math::Axis::X;
+                    return true;
+                case 1:
+                    ax = yourgame::math::Axis::Y;
+                    return true;
+                case 2:
+                    ax = yourgame::math::Axis::Z;
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            std::size_t len = 0;
+            const char *s = (lua_type(L, idx) == LUA_TSTRING) ? lua_tolstring(L, idx, &len) : nullptr;
+            if (s == nullptr || len != 1)
+            {
+                return false;
+            }
+            switch (s[0])
+            {
+            case 'X':
+                ax = yourgame::math::Axis::X;
+                return true;
+            case 'Y':
+                ax = yourgame::math::Axis::Y;
+                return true;
+            case 'Z':
+                ax = yourgame::math::Axis::Z;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // reads an axis vector (Vec3 or table) from the Lua stack at idx,
+        // normalized. false for the zero vector
+        bool toAxisVec(lua_State *L, int idx, glm::vec3 &v)
+        {
+            if (lua_type(L, idx) != LUA_TTABLE && lua_type(L, idx) != LUA_TUSERDATA)
+            {
+                return false;
+            }
+            v = readVec3(L, idx);
+            if (!(glm::length(v) > 0.0f))
+            {
+                return false;
+            }
+            v = glm::normalize(v);
+            return true;
+        }
+    } // namespace
+
+    // trafo:rotateGlobal(angle, ax)
+    int YgifTrafo::rotateGlobal(lua_State *L)
+    {
+        float angle = static_cast<float>(luaL_checknumber(L, 2));
+        yourgame::math::Axis ax;
+        glm::vec3 v;
+        if (toAxis(L, 3, ax))
+        {
+            yourgame::math::Trafo::rotateGlobal(angle, ax);
+        }
+        else if (toAxisVec(L, 3, v))
+        {
+            yourgame::math::Trafo::rotateGlobal(angle, v);
+        }
+        else
+        {
+            return luaL_error(L, "rotateGlobal(): invalid axis");
+        }
+        return 0;
+    }
+
+    // trafo:rotateLocal(angle, ax)
+    int YgifTrafo::rotateLocal(lua_State *L)
     {
-        if (ax == "X")
+        float angle = static_cast<float>(luaL_checknumber(L, 2));
+        yourgame::math::Axis ax;
+        glm::vec3 v;
+        if (toAxis(L, 3, ax))
         {
-            yourgame::math::Trafo::rotateGlobal(angle, yourgame::math::Axis::X);
+            yourgame::math::Trafo::rotateLocal(angle, ax);
         }
-        else if (ax == "Y")
+        else if (toAxisVec(L, 3, v))
         {
-            yourgame::math::Trafo::rotateGlobal(angle, yourgame::math::Axis::Y);
+            yourgame::math::Trafo::rotateLocal(angle, v);
         }
-        else if (ax == "Z")
+        else
         {
-            yourgame::math::Trafo::rotateGlobal(angle, yourgame::math::Axis::Z);
+            return luaL_error(L, "rotateLocal(): invalid axis");
         }
+        return 0;
     }
 
-    void YgifTrafo::rotateLocal(float angle, std::string const &ax)
+    void YgifTrafo::rotateEuler(float x, float y, float z)
     {
-        if (ax == "X")
+        if (x != 0.0f)
         {
-            yourgame::math::Trafo::rotateLocal(angle, yourgame::math::Axis::X);
+            yourgame::math::Trafo::rotateLocal(x, yourgame::math::Axis::X);
         }
-        else if (ax == "Y")
+        if (y != 0.0f)
         {
-            yourgame::math::Trafo::rotateLocal(angle, yourgame::math::Axis::Y);
+            yourgame::math::Trafo::rotateLocal(y, yourgame::math::Axis::Y);
         }
-        else if (ax == "Z")
+        if (z != 0.0f)
         {
-            yourgame::math::Trafo::rotateLocal(angle, yourgame::math::Axis::Z);
+            yourgame::math::Trafo::rotateLocal(z, yourgame::math::Axis::Z);
         }
     }
 
+    // trafo:setTRS(translation, rotation, scale)
+    int YgifTrafo::setTRS(lua_State *L)
+    {
+        if (!lua_isnoneornil(L, 2))
+        {
+            yourgame::math::Trafo::setTranslation(readVec3(L, 2));
+        }
+        if (!lua_isnoneornil(L, 3))
+        {
+            yourgame::math::Trafo::setRotation(readQuat(L, 3));
+        }
+        if (!lua_isnoneornil(L, 4))
+        {
+            yourgame::math::Trafo::setScaleLocal(readVec3(L, 4));
+        }
+        return 0;
+    }
+
     void YgifTrafo::translateLocal(glm::vec3 const &trans)
     {
         yourgame::math::Trafo::translateLocal(trans);
@@ -48,4 +169,64 @@ namespace mygame
     {
         yourgame::math::Trafo::setScaleLocal(scale);
     }
+
+    // trafo:getEyeInto(v)
+    int YgifTrafo::getEyeInto(lua_State *L)
+    {
+        writeVec3(L, 2, yourgame::math::Trafo::getEye());
+        lua_settop(L, 2);
+        return 1;
+    }
+
+    // trafo:getScaleInto(v)
+    int YgifTrafo::getScaleInto(lua_State *L)
+    {
+        writeVec3(L, 2, yourgame::math::Trafo::getScale());
+        lua_settop(L, 2);
+        return 1;
+    }
+
+    // trafo:getRotationInto(q)
+    int YgifTrafo::getRotationInto(lua_State *L)
+    {
+        writeQuat(L, 2, yourgame::math::Trafo::getRotation());
+        lua_settop(L, 2);
+        return 1;
+    }
+
+    // trafo:getAxisLocalInto(ax, v)
+    int YgifTrafo::getAxisLocalInto(lua_State *L)
+    {
+        yourgame::math::Axis ax;
+        if (!toAxis(L, 2, ax))
+        {
+            return luaL_error(L, "getAxisLocalInto(): invalid axis");
+        }
+        writeVec3(L, 3, yourgame::math::Trafo::getAxisLocal(ax));
+        lua_settop(L, 3);
+        return 1;
+    }
+
+    // trafo:getAxisGlobalInto(ax, v)
+    int YgifTrafo::getAxisGlobalInto(lua_State *L)
+    {
+        yourgame::math::Axis ax;
+        if (!toAxis(L, 2, ax))
+        {
+            return luaL_error(L, "getAxisGlobalInto(): invalid axis");
+        }
+        writeVec3(L, 3, yourgame::math::Trafo::getAxisGlobal(ax));
+        lua_settop(L, 3);
+        return 1;
+    }
+
+    void registerTrafoConstants(lua_State *L)
+    {
+        // values as accepted by toAxis()
+        setYgFields(L, "math", 3, [](lua_State *L, std::size_t i) {
+            static const char *const names[] = {"X", "Y", "Z"};
+            lua_pushstring(L, names[i]);
+            lua_pushinteger(L, static_cast<lua_Integer>(i));
+        });
+    }
 }
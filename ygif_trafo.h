@@ -1,20 +1,46 @@
 #ifndef YGIF_TRAFO_H
 #define YGIF_TRAFO_H
 
-#include <string>
 #include "yourgame/math/trafo.h"
 
+extern "C"
+{
+#include "lua.h"
+}
+
 namespace mygame
 {
     class YgifTrafo : yourgame::math::Trafo
     {
     public:
-        void rotateGlobal(float angle, std::string const &ax);
-        void rotateLocal(float angle, std::string const &ax);
+        // trafo:rotateGlobal(angle, ax), trafo:rotateLocal(angle, ax).
+        // ax: yg.math.X/Y/Z, an arbitrary axis (yg.math.Vec3 or table), or
+        // "X"/"Y"/"Z" (compatibility, slower). lua_CFunction members
+        int rotateGlobal(lua_State *L);
+        int rotateLocal(lua_State *L);
+
+        // local rotations around X, Y and Z, in this order
+        void rotateEuler(float x, float y, float z);
+
+        // trafo:setTRS(translation, rotation, scale): sets all three in one
+        // call, nil arguments are left unchanged (lua_CFunction member)
+        int setTRS(lua_State *L);
+
         void translateLocal(glm::vec3 const &trans);
         void translateGlobal(glm::vec3 const &trans);
         void setScaleLocal(glm::vec3 const &scale);
+
+        // "out parameter" variants, writing into an existing yg.math.Vec3/Quat
+        // or table instead of returning a new table (lua_CFunction members)
+        int getEyeInto(lua_State *L);
+        int getScaleInto(lua_State *L);
+        int getRotationInto(lua_State *L);
+        int getAxisLocalInto(lua_State *L);
+        int getAxisGlobalInto(lua_State *L);
     };
+
+    // sets the axis constants yg.math.X, yg.math.Y and yg.math.Z
+    void registerTrafoConstants(lua_State *L);
 }
 
 #endif
@@ -0,0 +1,204 @@
+#include <cmath>
+#include "ygif_trafopool.h"
+#include "ygif_vecmath.h"
+
+extern "C"
+{
+#include "lauxlib.h"
+}
+
+namespace mygame
+{
+    TrafoPool::TrafoPool(int n)
+        : m_size((n > 0) ? n : 0),
+          m_tx(m_size, 0.0f), m_ty(m_size, 0.0f), m_tz(m_size, 0.0f),
+          m_qx(m_size, 0.0f), m_qy(m_size, 0.0f), m_qz(m_size, 0.0f), m_qw(m_size, 1.0f),
+          m_sx(m_size, 1.0f), m_sy(m_size, 1.0f), m_sz(m_size, 1.0f),
+          m_rx(m_size, 0.0f), m_ry(m_size, 0.0f), m_rz(m_size, 0.0f),
+          m_gx(m_size, 0.0f), m_gy(m_size, 0.0f), m_gz(m_size, 0.0f),
+          m_mats(m_size, glm::mat4(1.0f))
+    {
+    }
+
+    int TrafoPool::size() const
+    {
+        return m_size;
+    }
+
+    void TrafoPool::setTranslation(int i, glm::vec3 const &t)
+    {
+        if (valid(i))
+        {
+            m_tx[i - 1] = t.x;
+            m_ty[i - 1] = t.y;
+            m_tz[i - 1] = t.z;
+            m_matsDirty = true;
+        }
+    }
+
+    void TrafoPool::setRotation(int i, glm::quat const &q)
+    {
+        if (valid(i))
+        {
+            glm::quat n = glm::normalize(q);
+            m_qx[i - 1] = n.x;
+            m_qy[i - 1] = n.y;
+            m_qz[i - 1] = n.z;
+            m_qw[i - 1] = n.w;
+            m_matsDirty = true;
+        }
+    }
+
+    void TrafoPool::setScale(int i, glm::vec3 const &s)
+    {
+        if (valid(i))
+        {
+            m_sx[i - 1] = s.x;
+            m_sy[i - 1] = s.y;
+            m_sz[i - 1] = s.z;
+            m_matsDirty = true;
+        }
+    }
+
+    void TrafoPool::setRotationRate(int i, glm::vec3 const &rate)
+    {
+        if (valid(i))
+        {
+            m_rx[i - 1] = rate.x;
+            m_ry[i - 1] = rate.y;
+            m_rz[i - 1] = rate.z;
+        }
+    }
+
+    void TrafoPool::setTarget(int i, glm::vec3 const &t)
+    {
+        if (valid(i))
+        {
+            m_gx[i - 1] = t.x;
+            m_gy[i - 1] = t.y;
+            m_gz[i - 1] = t.z;
+        }
+    }
+
+    glm::vec3 TrafoPool::getTranslation(int i) const
+    {
+        return valid(i) ? glm::vec3(m_tx[i - 1], m_ty[i - 1], m_tz[i - 1]) : glm::vec3(0.0f);
+    }
+
+    glm::quat TrafoPool::getRotation(int i) const
+    {
+        return valid(i) ? glm::quat(m_qw[i - 1], m_qx[i - 1], m_qy[i - 1], m_qz[i - 1]) : glm::quat(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    glm::vec3 TrafoPool::getScale(int i) const
+    {
+        return valid(i) ? glm::vec3(m_sx[i - 1], m_sy[i - 1], m_sz[i - 1]) : glm::vec3(0.0f);
+    }
+
+    // pool:getTranslationInto(i, v)
+    int TrafoPool::getTranslationInto(lua_State *L)
+    {
+        writeVec3(L, 3, getTranslation(static_cast<int>(luaL_checkinteger(L, 2))));
+        lua_settop(L, 3);
+        return 1;
+    }
+
+    // the bulk operations below are branch-free loops over the component
+    // arrays, written for auto-vectorization
+
+    void TrafoPool::translateAll(glm::vec3 const &trans)
+    {
+        float *tx = m_tx.data();
+        float *ty = m_ty.data();
+        float *tz = m_tz.data();
+        for (int i = 0; i < m_size; ++i)
+        {
+            tx[i] += trans.x;
+            ty[i] += trans.y;
+            tz[i] += trans.z;
+        }
+        m_matsDirty = true;
+    }
+
+    void TrafoPool::rotateAll(float dt)
+    {
+        float *qx = m_qx.data();
+        float *qy = m_qy.data();
+        float *qz = m_qz.data();
+        float *qw = m_qw.data();
+        float const *rx = m_rx.data();
+        float const *ry = m_ry.data();
+        float const *rz = m_rz.data();
+        for (int i = 0; i < m_size; ++i)
+        {
+            // delta rotation: angle |rate| * dt around rate / |rate|
+            float len = std::sqrt(rx[i] * rx[i] + ry[i] * ry[i] + rz[i] * rz[i]);
+            float halfAngle = 0.5f * len * dt;
+            float k = (len > 0.0f) ? std::sin(halfAngle) / len : 0.0f;
+            float dx = rx[i] * k;
+            float dy = ry[i] * k;
+            float dz = rz[i] * k;
+            float dw = std::cos(halfAngle);
+
+            // q = d * q (global rotation), normalized
+            float x = dw * qx[i] + dx * qw[i] + dy * qz[i] - dz * qy[i];
+            float y = dw * qy[i] - dx * qz[i] + dy * qw[i] + dz * qx[i];
+            float z = dw * qz[i] + dx * qy[i] - dy * qx[i] + dz * qw[i];
+            float w = dw * qw[i] - dx * qx[i] - dy * qy[i] - dz * qz[i];
+            float n = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+            qx[i] = x * n;
+            qy[i] = y * n;
+            qz[i] = z * n;
+            qw[i] = w * n;
+        }
+        m_matsDirty = true;
+    }
+
+    void TrafoPool::lerpToTargets(float t)
+    {
+        float *tx = m_tx.data();
+        float *ty = m_ty.data();
+        float *tz = m_tz.data();
+        float const *gx = m_gx.data();
+        float const *gy = m_gy.data();
+        float const *gz = m_gz.data();
+        for (int i = 0; i < m_size; ++i)
+        {
+            tx[i] += (gx[i] - tx[i]) * t;
+            ty[i] += (gy[i] - ty[i]) * t;
+            tz[i] += (gz[i] - tz[i]) * t;
+        }
+        m_matsDirty = true;
+    }
+
+    glm::mat4 const *TrafoPool::matrices()
+    {
+        if (m_matsDirty && m_size > 0)
+        {
+            // translation * rotation * scale, column-major
+            float *m = &m_mats[0][0][0];
+            for (int i = 0; i < m_size; ++i, m += 16)
+            {
+                float x = m_qx[i], y = m_qy[i], z = m_qz[i], w = m_qw[i];
+                m[0] = (1.0f - 2.0f * (y * y + z * z)) * m_sx[i];
+                m[1] = 2.0f * (x * y + w * z) * m_sx[i];
+                m[2] = 2.0f * (x * z - w * y) * m_sx[i];
+                m[3] = 0.0f;
+                m[4] = 2.0f * (x * y - w * z) * m_sy[i];
+                m[5] = (1.0f - 2.0f * (x * x + z * z)) * m_sy[i];
+                m[6] = 2.0f * (y * z + w * x) * m_sy[i];
+                m[7] = 0.0f;
+                m[8] = 2.0f * (x * z + w * y) * m_sz[i];
+                m[9] = 2.0f * (y * z - w * x) * m_sz[i];
+                m[10] = (1.0f - 2.0f * (x * x + y * y)) * m_sz[i];
+                m[11] = 0.0f;
+                m[12] = m_tx[i];
+                m[13] = m_ty[i];
+                m[14] = m_tz[i];
+                m[15] = 1.0f;
+            }
+        }
+        m_matsDirty = false;
+        return m_mats.empty() ? nullptr : &m_mats[0];
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef YGIF_TRAFOPOOL_H
+#define YGIF_TRAFOPOOL_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // n transformations (translation, rotation, scale) in structure-of-arrays
+    // storage, for scripts with many objects (yg.math.TrafoPool). bulk
+    // operations run as plain loops over the component arrays, model matrices
+    // are computed for all elements at once and drawn instanced from the
+    // matrix array (DrawList::addPool()).
+    // element indices are 1-based, like Lua arrays. setters ignore indices
+    // out of range, getters return zero vectors for them.
+    class TrafoPool
+    {
+    public:
+        explicit TrafoPool(int n);
+
+        int size() const;
+
+        void setTranslation(int i, glm::vec3 const &t);
+        void setRotation(int i, glm::quat const &q);
+        void setScale(int i, glm::vec3 const &s);
+        // angular velocity [rad/s] around the global axis rate/|rate|, see rotateAll()
+        void setRotationRate(int i, glm::vec3 const &rate);
+        // target translation, see lerpToTargets()
+        void setTarget(int i, glm::vec3 const &t);
+
+        glm::vec3 getTranslation(int i) const;
+        glm::quat getRotation(int i) const;
+        glm::vec3 getScale(int i) const;
+
+        // pool:getTranslationInto(i, v), writes into an existing yg.math.Vec3 or table
+        int getTranslationInto(lua_State *L);
+
+        // bulk operations on all elements
+        void translateAll(glm::vec3 const &trans);
+        void rotateAll(float dt); // by the rotation rates
+        void lerpToTargets(float t); // translation += (target - translation) * t
+
+        // model matrices of all elements, updated if the pool changed since
+        // the last call
+        glm::mat4 const *matrices();
+
+    private:
+        bool valid(int i) const { return i >= 1 && i <= m_size; }
+
+        int m_size;
+        std::vector<float> m_tx, m_ty, m_tz;       // translation
+        std::vector<float> m_qx, m_qy, m_qz, m_qw; // rotation
+        std::vector<float> m_sx, m_sy, m_sz;       // scale
+        std::vector<float> m_rx, m_ry, m_rz;       // rotation rate
+        std::vector<float> m_gx, m_gy, m_gz;       // target translation
+        std::vector<glm::mat4> m_mats;
+        bool m_matsDirty = true;
+    };
+}
+
+#endif
@@ -0,0 +1,557 @@
+#include <cstdio>
+#include <cstring>
+#include "ygif_vecmath.h"
+#include "ygif_glue.h"
+#include "ygif_luacompat.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+#include "LuaBridge/LuaBridge.h"
+
+// LuaBridge Stacks for glm
+#include "LuaBridge_glmVec3.h"
+#include "LuaBridge_glmQuat.h"
+
+namespace mygame
+{
+    namespace
+    {
+        // maps the key at idx to a component index: integer 1..n, or one of the
+        // single-character component names. returns -1 for any other key
+        int toComponent(lua_State *L, int idx, int n, const char *names)
+        {
+            switch (lua_type(L, idx))
+            {
+            case LUA_TNUMBER:
+            {
+                lua_Integer i = lua_tointeger(L, idx);
+                return (i >= 1 && i <= n) ? static_cast<int>(i - 1) : -1;
+            }
+            case LUA_TSTRING:
+            {
+                std::size_t len = 0;
+                const char *k = lua_tolstring(L, idx, &len);
+                const char *c = (len == 1) ? std::strchr(names, k[0]) : nullptr;
+                return (c != nullptr && *c != '\0') ? static_cast<int>(c - names) : -1;
+            }
+            default:
+                return -1;
+            }
+        }
+
+        glm::vec3 *checkVec3(lua_State *L, int idx)
+        {
+            return static_cast<glm::vec3 *>(luaL_checkudata(L, idx, luabridge::glmVec3MetatableName));
+        }
+
+        glm::quat *checkQuat(lua_State *L, int idx)
+        {
+            return static_cast<glm::quat *>(luaL_checkudata(L, idx, luabridge::glmQuatMetatableName));
+        }
+
+        glm::vec3 toVec3(lua_State *L, int idx)
+        {
+            return luabridge::Stack<glm::vec3>::get(L, idx);
+        }
+
+        glm::quat toQuat(lua_State *L, int idx)
+        {
+            return luabridge::Stack<glm::quat>::get(L, idx);
+        }
+
+        // Vec3 ...
+        int vec3_new(lua_State *L)
+        {
+            if (lua_gettop(L) == 0)
+            {
+                pushVec3(L, glm::vec3(0.0f));
+            }
+            else if (lua_type(L, 1) == LUA_TNUMBER)
+            {
+                pushVec3(L, glm::vec3(static_cast<float>(luaL_checknumber(L, 1)),
+                                      static_cast<float>(luaL_checknumber(L, 2)),
+                                      static_cast<float>(luaL_checknumber(L, 3))));
+            }
+            else
+            {
+                pushVec3(L, toVec3(L, 1));
+            }
+            return 1;
+        }
+
+        int vec3_index(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            int c = toComponent(L, 2, 3, "xyz");
+            if (c >= 0)
+            {
+                lua_pushnumber(L, (*v)[c]);
+                return 1;
+            }
+            // methods table
+            lua_pushvalue(L, 2);
+            lua_rawget(L, lua_upvalueindex(1));
+            return 1;
+        }
+
+        int vec3_newindex(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            int c = toComponent(L, 2, 3, "xyz");
+            if (c < 0)
+            {
+                return luaL_error(L, "yg.math.Vec3: invalid component");
+            }
+            (*v)[c] = static_cast<float>(luaL_checknumber(L, 3));
+            return 0;
+        }
+
+        int vec3_add(lua_State *L)
+        {
+            pushVec3(L, toVec3(L, 1) + toVec3(L, 2));
+            return 1;
+        }
+
+        int vec3_sub(lua_State *L)
+        {
+            pushVec3(L, toVec3(L, 1) - toVec3(L, 2));
+            return 1;
+        }
+
+        int vec3_mul(lua_State *L)
+        {
+            if (lua_type(L, 1) == LUA_TNUMBER)
+            {
+                pushVec3(L, static_cast<float>(lua_tonumber(L, 1)) * toVec3(L, 2));
+            }
+            else if (lua_type(L, 2) == LUA_TNUMBER)
+            {
+                pushVec3(L, toVec3(L, 1) * static_cast<float>(lua_tonumber(L, 2)));
+            }
+            else
+            {
+                pushVec3(L, toVec3(L, 1) * toVec3(L, 2));
+            }
+            return 1;
+        }
+
+        int vec3_div(lua_State *L)
+        {
+            if (lua_type(L, 2) == LUA_TNUMBER)
+            {
+                pushVec3(L, toVec3(L, 1) / static_cast<float>(lua_tonumber(L, 2)));
+            }
+            else
+            {
+                pushVec3(L, toVec3(L, 1) / toVec3(L, 2));
+            }
+            return 1;
+        }
+
+        int vec3_unm(lua_State *L)
+        {
+            pushVec3(L, -(*checkVec3(L, 1)));
+            return 1;
+        }
+
+        int vec3_eq(lua_State *L)
+        {
+            glm::vec3 *a = static_cast<glm::vec3 *>(luaL_testudata(L, 1, luabridge::glmVec3MetatableName));
+            glm::vec3 *b = static_cast<glm::vec3 *>(luaL_testudata(L, 2, luabridge::glmVec3MetatableName));
+            lua_pushboolean(L, a != nullptr && b != nullptr && *a == *b);
+            return 1;
+        }
+
+        int vec3_len(lua_State *L)
+        {
+            lua_pushinteger(L, 3);
+            return 1;
+        }
+
+        int vec3_tostring(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            char buf[96];
+            std::snprintf(buf, sizeof(buf), "Vec3(%g, %g, %g)", v->x, v->y, v->z);
+            lua_pushstring(L, buf);
+            return 1;
+        }
+
+        // in-place methods return self
+        int vec3_set(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            if (lua_type(L, 2) == LUA_TNUMBER)
+            {
+                *v = glm::vec3(static_cast<float>(luaL_checknumber(L, 2)),
+                               static_cast<float>(luaL_checknumber(L, 3)),
+                               static_cast<float>(luaL_checknumber(L, 4)));
+            }
+            else
+            {
+                *v = toVec3(L, 2);
+            }
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int vec3_addInPlace(lua_State *L)
+        {
+            *checkVec3(L, 1) += toVec3(L, 2);
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int vec3_subInPlace(lua_State *L)
+        {
+            *checkVec3(L, 1) -= toVec3(L, 2);
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int vec3_scaleInPlace(lua_State *L)
+        {
+            *checkVec3(L, 1) *= static_cast<float>(luaL_checknumber(L, 2));
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int vec3_normalize(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            if (glm::dot(*v, *v) > 0.0f)
+            {
+                *v = glm::normalize(*v);
+            }
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int vec3_dot(lua_State *L)
+        {
+            lua_pushnumber(L, glm::dot(*checkVec3(L, 1), toVec3(L, 2)));
+            return 1;
+        }
+
+        int vec3_cross(lua_State *L)
+        {
+            pushVec3(L, glm::cross(*checkVec3(L, 1), toVec3(L, 2)));
+            return 1;
+        }
+
+        int vec3_length(lua_State *L)
+        {
+            lua_pushnumber(L, glm::length(*checkVec3(L, 1)));
+            return 1;
+        }
+
+        int vec3_copy(lua_State *L)
+        {
+            pushVec3(L, *checkVec3(L, 1));
+            return 1;
+        }
+
+        int vec3_unpack(lua_State *L)
+        {
+            glm::vec3 *v = checkVec3(L, 1);
+            lua_pushnumber(L, v->x);
+            lua_pushnumber(L, v->y);
+            lua_pushnumber(L, v->z);
+            return 3;
+        }
+
+        const luaL_Reg vec3Metamethods[] = {
+            {"__newindex", vec3_newindex},
+            {"__add", vec3_add},
+            {"__sub", vec3_sub},
+            {"__mul", vec3_mul},
+            {"__div", vec3_div},
+            {"__unm", vec3_unm},
+            {"__eq", vec3_eq},
+            {"__len", vec3_len},
+            {"__tostring", vec3_tostring},
+            {nullptr, nullptr}};
+
+        const luaL_Reg vec3Methods[] = {
+            {"set", vec3_set},
+            {"add", vec3_addInPlace},
+            {"sub", vec3_subInPlace},
+            {"scale", vec3_scaleInPlace},
+            {"normalize", vec3_normalize},
+            {"dot", vec3_dot},
+            {"cross", vec3_cross},
+            {"length", vec3_length},
+            {"copy", vec3_copy},
+            {"unpack", vec3_unpack},
+            {nullptr, nullptr}};
+
+        // Quat ...
+        // components are ordered x, y, z, w, like the 4-element table
+        // representation of glm::quat (see LuaBridge_glmQuat.h)
+        int quat_new(lua_State *L)
+        {
+            if (lua_gettop(L) == 0)
+            {
+                pushQuat(L, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+            }
+            else if (lua_type(L, 1) == LUA_TNUMBER)
+            {
+                pushQuat(L, glm::quat(static_cast<float>(luaL_checknumber(L, 4)),
+                                      static_cast<float>(luaL_checknumber(L, 1)),
+                                      static_cast<float>(luaL_checknumber(L, 2)),
+                                      static_cast<float>(luaL_checknumber(L, 3))));
+            }
+            else
+            {
+                pushQuat(L, toQuat(L, 1));
+            }
+            return 1;
+        }
+
+        int quat_index(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            int c = toComponent(L, 2, 4, "xyzw");
+            if (c >= 0)
+            {
+                lua_pushnumber(L, (*q)[c]);
+                return 1;
+            }
+            // methods table
+            lua_pushvalue(L, 2);
+            lua_rawget(L, lua_upvalueindex(1));
+            return 1;
+        }
+
+        int quat_newindex(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            int c = toComponent(L, 2, 4, "xyzw");
+            if (c < 0)
+            {
+                return luaL_error(L, "yg.math.Quat: invalid component");
+            }
+            (*q)[c] = static_cast<float>(luaL_checknumber(L, 3));
+            return 0;
+        }
+
+        // quat * quat -> Quat, quat * vec3 -> Vec3 (rotated)
+        int quat_mul(lua_State *L)
+        {
+            glm::quat q = toQuat(L, 1);
+            if (luaL_testudata(L, 2, luabridge::glmVec3MetatableName) != nullptr ||
+                (lua_istable(L, 2) && lua_rawlen(L, 2) == 3))
+            {
+                pushVec3(L, q * toVec3(L, 2));
+            }
+            else
+            {
+                pushQuat(L, q * toQuat(L, 2));
+            }
+            return 1;
+        }
+
+        int quat_eq(lua_State *L)
+        {
+            glm::quat *a = static_cast<glm::quat *>(luaL_testudata(L, 1, luabridge::glmQuatMetatableName));
+            glm::quat *b = static_cast<glm::quat *>(luaL_testudata(L, 2, luabridge::glmQuatMetatableName));
+            lua_pushboolean(L, a != nullptr && b != nullptr && *a == *b);
+            return 1;
+        }
+
+        int quat_len(lua_State *L)
+        {
+            lua_pushinteger(L, 4);
+            return 1;
+        }
+
+        int quat_tostring(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "Quat(%g, %g, %g, %g)", q->x, q->y, q->z, q->w);
+            lua_pushstring(L, buf);
+            return 1;
+        }
+
+        // in-place methods return self
+        int quat_set(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            if (lua_type(L, 2) == LUA_TNUMBER)
+            {
+                *q = glm::quat(static_cast<float>(luaL_checknumber(L, 5)),
+                               static_cast<float>(luaL_checknumber(L, 2)),
+                               static_cast<float>(luaL_checknumber(L, 3)),
+                               static_cast<float>(luaL_checknumber(L, 4)));
+            }
+            else
+            {
+                *q = toQuat(L, 2);
+            }
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int quat_normalize(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            *q = glm::normalize(*q);
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        int quat_conjugate(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            *q = glm::conjugate(*q);
+            lua_settop(L, 1);
+            return 1;
+        }
+
+        // q:rotate(v) rotates v (Vec3 or table) in place, returns v
+        int quat_rotate(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            writeVec3(L, 2, (*q) * toVec3(L, 2));
+            lua_settop(L, 2);
+            return 1;
+        }
+
+        int quat_copy(lua_State *L)
+        {
+            pushQuat(L, *checkQuat(L, 1));
+            return 1;
+        }
+
+        int quat_unpack(lua_State *L)
+        {
+            glm::quat *q = checkQuat(L, 1);
+            lua_pushnumber(L, q->x);
+            lua_pushnumber(L, q->y);
+            lua_pushnumber(L, q->z);
+            lua_pushnumber(L, q->w);
+            return 4;
+        }
+
+        const luaL_Reg quatMetamethods[] = {
+            {"__newindex", quat_newindex},
+            {"__mul", quat_mul},
+            {"__eq", quat_eq},
+            {"__len", quat_len},
+            {"__tostring", quat_tostring},
+            {nullptr, nullptr}};
+
+        const luaL_Reg quatMethods[] = {
+            {"set", quat_set},
+            {"normalize", quat_normalize},
+            {"conjugate", quat_conjugate},
+            {"rotate", quat_rotate},
+            {"copy", quat_copy},
+            {"unpack", quat_unpack},
+            {nullptr, nullptr}};
+
+        // creates metatable mtName with the given metamethods and an __index
+        // function (component access, then methods)
+        void makeMetatable(lua_State *L,
+                           const char *mtName,
+                           const luaL_Reg *metamethods,
+                           const luaL_Reg *methods,
+                           lua_CFunction index)
+        {
+            luaL_newmetatable(L, mtName);
+            luaL_setfuncs(L, metamethods, 0);
+            lua_newtable(L);
+            luaL_setfuncs(L, methods, 0);
+            lua_pushcclosure(L, index, 1);
+            lua_setfield(L, -2, "__index");
+            lua_pop(L, 1);
+        }
+    } // namespace
+
+    glm::vec3 *pushVec3(lua_State *L, glm::vec3 const &v)
+    {
+        glm::vec3 *ud = static_cast<glm::vec3 *>(lua_newuserdata(L, sizeof(glm::vec3)));
+        *ud = v;
+        luaL_setmetatable(L, luabridge::glmVec3MetatableName);
+        return ud;
+    }
+
+    glm::quat *pushQuat(lua_State *L, glm::quat const &q)
+    {
+        glm::quat *ud = static_cast<glm::quat *>(lua_newuserdata(L, sizeof(glm::quat)));
+        *ud = q;
+        luaL_setmetatable(L, luabridge::glmQuatMetatableName);
+        return ud;
+    }
+
+    glm::vec3 readVec3(lua_State *L, int idx)
+    {
+        return toVec3(L, idx);
+    }
+
+    glm::quat readQuat(lua_State *L, int idx)
+    {
+        return toQuat(L, idx);
+    }
+
+    void writeVec3(lua_State *L, int idx, glm::vec3 const &v)
+    {
+        glm::vec3 *ud = static_cast<glm::vec3 *>(luaL_testudata(L, idx, luabridge::glmVec3MetatableName));
+        if (ud != nullptr)
+        {
+            *ud = v;
+        }
+        else if (lua_istable(L, idx))
+        {
+            idx = lua_absindex(L, idx);
+            for (int i = 0; i < 3; ++i)
+            {
+                lua_pushnumber(L, v[i]);
+                lua_rawseti(L, idx, i + 1);
+            }
+        }
+        else
+        {
+            luaL_error(L, "#%d argument must be table or yg.math.Vec3", idx);
+        }
+    }
+
+    void writeQuat(lua_State *L, int idx, glm::quat const &q)
+    {
+        glm::quat *ud = static_cast<glm::quat *>(luaL_testudata(L, idx, luabridge::glmQuatMetatableName));
+        if (ud != nullptr)
+        {
+            *ud = q;
+        }
+        else if (lua_istable(L, idx))
+        {
+            idx = lua_absindex(L, idx);
+            for (int i = 0; i < 4; ++i)
+            {
+                lua_pushnumber(L, q[i]);
+                lua_rawseti(L, idx, i + 1);
+            }
+        }
+        else
+        {
+            luaL_error(L, "#%d argument must be table or yg.math.Quat", idx);
+        }
+    }
+
+    void registerVecMath(lua_State *L)
+    {
+        makeMetatable(L, luabridge::glmVec3MetatableName, vec3Metamethods, vec3Methods, vec3_index);
+        makeMetatable(L, luabridge::glmQuatMetatableName, quatMetamethods, quatMethods, quat_index);
+
+        // yg.math.Vec3(), yg.math.Quat() constructors
+        setYgFields(L, "math", 2, [](lua_State *L, std::size_t i) {
+            lua_pushstring(L, (i == 0) ? "Vec3" : "Quat");
+            lua_pushcfunction(L, (i == 0) ? vec3_new : quat_new);
+        });
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef YGIF_VECMATH_H
+#define YGIF_VECMATH_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+extern "C"
+{
+#include "lua.h"
+}
+
+namespace mygame
+{
+    // registers the full userdata types yg.math.Vec3 and yg.math.Quat.
+    // both are accepted wherever a glm::vec3 (3-element table) or a
+    // glm::quat (4-element table) is expected.
+    void registerVecMath(lua_State *L);
+
+    // pushes a new yg.math.Vec3/yg.math.Quat, returns a pointer to its data
+    glm::vec3 *pushVec3(lua_State *L, glm::vec3 const &v);
+    glm::quat *pushQuat(lua_State *L, glm::quat const &q);
+
+    // reads a yg.math.Vec3/yg.math.Quat or table at idx
+    glm::vec3 readVec3(lua_State *L, int idx);
+    glm::quat readQuat(lua_State *L, int idx);
+
+    // writes v/q into the existing yg.math.Vec3/yg.math.Quat or table at idx,
+    // without allocating ("out parameter"). raises a Lua error otherwise.
+    void writeVec3(lua_State *L, int idx, glm::vec3 const &v);
+    void writeQuat(lua_State *L, int idx, glm::quat const &q);
+}
+
+#endif